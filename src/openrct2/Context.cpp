@@ -862,7 +862,11 @@ namespace OpenRCT2
                 _variableFrame = useVariableFrame;
             }
 
-            if (useVariableFrame)
+            if (game_is_turbo_mode_active() && game_is_not_paused())
+            {
+                RunTurboFrame();
+            }
+            else if (useVariableFrame)
             {
                 RunVariableFrame();
             }
@@ -908,6 +912,26 @@ namespace OpenRCT2
             }
         }
 
+        void RunTurboFrame()
+        {
+            _uiContext->ProcessMessages();
+
+            // Runs ticks for the whole render interval
+            Update();
+
+            // Don't try to catch up on the time spent in the turbo ticks once turbo mode ends
+            _lastTick = 0;
+            _accumulator = 0;
+
+            if (!_isWindowMinimised && !gOpenRCT2Headless)
+            {
+                _drawingEngine->BeginDraw();
+                _painter->Paint(*_drawingEngine);
+                _drawingEngine->EndDraw();
+                _drawingEngine->UpdateWindows();
+            }
+        }
+
         void RunVariableFrame()
         {
             uint32_t currentTick = platform_get_ticks();
@@ -56,6 +56,7 @@
 #include "world/Footpath.h"
 #include "world/Map.h"
 #include "world/MapAnimation.h"
+#include "world/LitterIndex.h"
 #include "world/Park.h"
 #include "world/Scenery.h"
 #include "world/Sprite.h"
@@ -72,6 +73,11 @@ int32_t gGameSpeed = 1;
 bool gDoSingleUpdate = false;
 float gDayNightCycle = 0;
 bool gInUpdateCode = false;
+// Runs as many ticks as possible between frames, only redrawing every gTurboModeRenderInterval milliseconds.
+bool gTurboMode = false;
+uint32_t gTurboModeRenderInterval = 1000;
+// Set while the ticks of a turbo frame are running, during which nothing is invalidated or played.
+bool gInTurboUpdate = false;
 bool gInMapInitCode = false;
 std::string gCurrentLoadedPath;
 
@@ -304,6 +310,13 @@ bool game_is_not_paused()
     return gGamePaused == 0;
 }
 
+bool game_is_turbo_mode_active()
+{
+    // Clients have to follow the server and clients of a server would not be able to keep up.
+    return gTurboMode && network_get_mode() == NETWORK_MODE_NONE
+        && !(gScreenFlags & (SCREEN_FLAGS_TITLE_DEMO | SCREEN_FLAGS_EDITOR));
+}
+
 /**
  *
  *  rct2: 0x0066DC0F
@@ -560,6 +573,8 @@ void game_load_init()
         GameActions::ClearQueue();
         reset_sprite_spatial_index();
     }
+    // Clients keep the spatial index of the park they received, but the litter index still has to be rebuilt.
+    gLitterIndex.Invalidate();
     reset_all_sprite_quadrant_placements();
     scenery_set_default_placement_configuration();
 
@@ -140,6 +140,9 @@ extern int32_t gGameSpeed;
 extern bool gDoSingleUpdate;
 extern float gDayNightCycle;
 extern bool gInUpdateCode;
+extern bool gTurboMode;
+extern uint32_t gTurboModeRenderInterval;
+extern bool gInTurboUpdate;
 extern bool gInMapInitCode;
 extern std::string gCurrentLoadedPath;
 
@@ -158,6 +161,7 @@ void game_load_init();
 void pause_toggle();
 bool game_is_paused();
 bool game_is_not_paused();
+bool game_is_turbo_mode_active();
 void save_game();
 void* create_save_game_as_intent();
 void save_game_as();
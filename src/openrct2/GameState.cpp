@@ -16,8 +16,10 @@
 #include "Input.h"
 #include "OpenRCT2.h"
 #include "ReplayManager.h"
+#include "TickProfiler.h"
 #include "actions/GameAction.h"
 #include "config/Config.h"
+#include "drawing/Drawing.h"
 #include "interface/Screenshot.h"
 #include "localisation/Date.h"
 #include "localisation/Localisation.h"
@@ -158,6 +160,11 @@ void GameState::Update()
     }
 
     // Update the game one or more times
+    if (!isPaused && game_is_turbo_mode_active())
+    {
+        UpdateTurbo();
+        numUpdates = 0;
+    }
     for (uint32_t i = 0; i < numUpdates; i++)
     {
         UpdateLogic();
@@ -225,78 +232,135 @@ void GameState::Update()
 
 void GameState::UpdateLogic()
 {
+    TickProfiler::TickScope tickScope(gTickProfiler);
+
     gScreenAge++;
     if (gScreenAge == 0)
         gScreenAge--;
 
-    GetContext()->GetReplayManager()->Update();
-
-    network_update();
-
-    if (network_get_mode() == NETWORK_MODE_SERVER)
     {
-        if (network_gamestate_snapshots_enabled())
-        {
-            CreateStateSnapshot();
-        }
-
-        // Send current tick out.
-        network_send_tick();
+        TickProfiler::StageScope stageScope(gTickProfiler, TickStage::ReplayManager);
+        GetContext()->GetReplayManager()->Update();
     }
-    else if (network_get_mode() == NETWORK_MODE_CLIENT)
+
     {
-        // Don't run past the server, this condition can happen during map changes.
-        if (network_get_server_tick() == gCurrentTicks)
-        {
-            return;
-        }
+        TickProfiler::StageScope stageScope(gTickProfiler, TickStage::Network);
+        network_update();
 
-        // Check desync.
-        bool desynced = network_check_desynchronisation();
-        if (desynced)
+        if (network_get_mode() == NETWORK_MODE_SERVER)
         {
-            // If desync debugging is enabled and we are still connected request the specific game state from server.
-            if (network_gamestate_snapshots_enabled() && network_get_status() == NETWORK_STATUS_CONNECTED)
+            if (network_gamestate_snapshots_enabled())
             {
-                // Create snapshot from this tick so we can compare it later
-                // as we won't pause the game on this event.
                 CreateStateSnapshot();
+            }
+
+            // Send current tick out.
+            network_send_tick();
+        }
+        else if (network_get_mode() == NETWORK_MODE_CLIENT)
+        {
+            // Don't run past the server, this condition can happen during map changes.
+            if (network_get_server_tick() == gCurrentTicks)
+            {
+                tickScope.Discard();
+                return;
+            }
 
-                network_request_gamestate_snapshot();
+            // Check desync.
+            bool desynced = network_check_desynchronisation();
+            if (desynced)
+            {
+                // If desync debugging is enabled and we are still connected request the specific game state from server.
+                if (network_gamestate_snapshots_enabled() && network_get_status() == NETWORK_STATUS_CONNECTED)
+                {
+                    // Create snapshot from this tick so we can compare it later
+                    // as we won't pause the game on this event.
+                    CreateStateSnapshot();
+
+                    network_request_gamestate_snapshot();
+                }
             }
         }
     }
 
-    date_update();
-    _date = Date(gDateMonthTicks, gDateMonthTicks);
-
-    scenario_update();
-    climate_update();
-    map_update_tiles();
-    // Temporarily remove provisional paths to prevent peep from interacting with them
-    map_remove_provisional_elements();
-    map_update_path_wide_flags();
-    peep_update_all();
-    map_restore_provisional_elements();
-    vehicle_update_all();
-    sprite_misc_update_all();
-    Ride::UpdateAll();
+    {
+        TickProfiler::StageScope stageScope(gTickProfiler, TickStage::Date);
+        date_update();
+        _date = Date(gDateMonthTicks, gDateMonthTicks);
+    }
+
+    {
+        TickProfiler::StageScope stageScope(gTickProfiler, TickStage::Scenario);
+        scenario_update();
+    }
+    {
+        TickProfiler::StageScope stageScope(gTickProfiler, TickStage::Climate);
+        climate_update();
+    }
+    {
+        TickProfiler::StageScope stageScope(gTickProfiler, TickStage::MapTiles);
+        map_update_tiles();
+    }
+    {
+        TickProfiler::StageScope stageScope(gTickProfiler, TickStage::Peeps);
+        // Temporarily remove provisional paths to prevent peep from interacting with them
+        map_remove_provisional_elements();
+        map_update_path_wide_flags();
+        peep_update_all();
+        map_restore_provisional_elements();
+    }
+    {
+        TickProfiler::StageScope stageScope(gTickProfiler, TickStage::Vehicles);
+        vehicle_update_all();
+    }
+    {
+        TickProfiler::StageScope stageScope(gTickProfiler, TickStage::MiscSprites);
+        sprite_misc_update_all();
+    }
+    {
+        TickProfiler::StageScope stageScope(gTickProfiler, TickStage::Rides);
+        Ride::UpdateAll();
+    }
 
     if (!(gScreenFlags & SCREEN_FLAGS_EDITOR))
     {
+        TickProfiler::StageScope stageScope(gTickProfiler, TickStage::Park);
         _park->Update(_date);
     }
 
-    research_update();
-    ride_ratings_update_all();
-    ride_measurements_update();
-    news_item_update_current();
-
-    map_animation_invalidate_all();
-    vehicle_sounds_update();
-    peep_update_crowd_noise();
-    climate_update_sound();
-    editor_open_windows_for_current_step();
+    {
+        TickProfiler::StageScope stageScope(gTickProfiler, TickStage::Research);
+        research_update();
+    }
+    {
+        TickProfiler::StageScope stageScope(gTickProfiler, TickStage::RideRatings);
+        ride_ratings_update_all();
+    }
+    {
+        TickProfiler::StageScope stageScope(gTickProfiler, TickStage::RideMeasurements);
+        ride_measurements_update();
+    }
+    {
+        TickProfiler::StageScope stageScope(gTickProfiler, TickStage::News);
+        news_item_update_current();
+    }
+    {
+        TickProfiler::StageScope stageScope(gTickProfiler, TickStage::MapAnimations);
+        map_animation_invalidate_all();
+    }
+    {
+        TickProfiler::StageScope stageScope(gTickProfiler, TickStage::Sounds);
+        if (!gInTurboUpdate)
+        {
+            vehicle_sounds_update();
+            peep_update_crowd_noise();
+            climate_update_sound();
+        }
+    }
+    {
+        TickProfiler::StageScope stageScope(gTickProfiler, TickStage::EditorWindows);
+        editor_open_windows_for_current_step();
+    }
 
     // Update windows
     // window_dispatch_update_all();
@@ -307,16 +371,41 @@ void GameState::UpdateLogic()
         gLastAutoSaveUpdate = Platform::GetTicks();
     }
 
-    GameActions::ProcessQueue();
+    {
+        TickProfiler::StageScope stageScope(gTickProfiler, TickStage::GameActions);
+        GameActions::ProcessQueue();
+    }
 
-    network_process_pending();
-    network_flush();
+    {
+        TickProfiler::StageScope stageScope(gTickProfiler, TickStage::NetworkFlush);
+        network_process_pending();
+        network_flush();
+    }
 
     gCurrentTicks++;
     gScenarioTicks++;
     gSavedAge++;
 }
 
+/**
+ * Runs ticks until the render interval has passed, or the game gets paused. Ticks run exactly as they would at normal
+ * speed, except that nothing gets invalidated and no sounds are updated, the whole screen is invalidated at the end
+ * instead.
+ */
+void GameState::UpdateTurbo()
+{
+    uint32_t startTime = Platform::GetTicks();
+    gInTurboUpdate = true;
+    do
+    {
+        UpdateLogic();
+    } while (Platform::GetTicks() - startTime < gTurboModeRenderInterval && game_is_not_paused()
+             && game_is_turbo_mode_active());
+    gInTurboUpdate = false;
+
+    gfx_invalidate_screen();
+}
+
 void GameState::CreateStateSnapshot()
 {
     IGameStateSnapshots* snapshots = GetContext()->GetGameStateSnapshots();
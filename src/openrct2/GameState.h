@@ -44,6 +44,7 @@ namespace OpenRCT2
         void UpdateLogic();
 
     private:
+        void UpdateTurbo();
         void CreateStateSnapshot();
     };
 } // namespace OpenRCT2
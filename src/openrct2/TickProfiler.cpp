@@ -0,0 +1,305 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TickProfiler.h"
+
+#include "core/File.h"
+#include "core/Json.hpp"
+#include "core/String.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+TickProfiler gTickProfiler;
+
+// clang-format off
+static constexpr const char* TickStageNames[] = {
+    "replay_manager",
+    "network",
+    "date",
+    "scenario",
+    "climate",
+    "map_tiles",
+    "peeps",
+    "vehicles",
+    "misc_sprites",
+    "rides",
+    "park",
+    "research",
+    "ride_ratings",
+    "ride_measurements",
+    "news",
+    "map_animations",
+    "sounds",
+    "editor_windows",
+    "game_actions",
+    "network_flush",
+};
+// clang-format on
+static_assert(std::size(TickStageNames) == TickProfiler::NumStages, "Missing tick stage names");
+
+static uint64_t GetElapsedNanoseconds(std::chrono::steady_clock::time_point start)
+{
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+}
+
+TickProfiler::TickScope::TickScope(TickProfiler& profiler)
+{
+    if (profiler._enabled)
+    {
+        _profiler = &profiler;
+        _profiler->_currentStages.fill(0);
+        _start = std::chrono::steady_clock::now();
+    }
+}
+
+TickProfiler::TickScope::~TickScope()
+{
+    if (_profiler != nullptr && _profiler->_enabled)
+    {
+        _profiler->AddTick(_profiler->_currentStages, GetElapsedNanoseconds(_start));
+    }
+}
+
+TickProfiler::StageScope::StageScope(TickProfiler& profiler, TickStage stage)
+    : _stage(stage)
+{
+    if (profiler._enabled)
+    {
+        _profiler = &profiler;
+        _start = std::chrono::steady_clock::now();
+    }
+}
+
+TickProfiler::StageScope::~StageScope()
+{
+    if (_profiler != nullptr)
+    {
+        _profiler->_currentStages[(size_t)_stage] += GetElapsedNanoseconds(_start);
+    }
+}
+
+void TickProfiler::SetEnabled(bool enabled)
+{
+    _enabled = enabled;
+}
+
+void TickProfiler::Reset()
+{
+    _history.clear();
+    _history.shrink_to_fit();
+    _historyHead = 0;
+    _totalTicks = 0;
+}
+
+void TickProfiler::AddTick(const std::array<uint64_t, NumStages>& stages, uint64_t total)
+{
+    TickRecord record = { stages, total };
+    if (_history.size() < HistorySize)
+    {
+        _history.push_back(record);
+    }
+    else
+    {
+        _history[_historyHead] = record;
+        _historyHead = (_historyHead + 1) % HistorySize;
+    }
+    _totalTicks++;
+}
+
+size_t TickProfiler::GetNumTicks() const
+{
+    return _history.size();
+}
+
+const TickProfiler::TickRecord& TickProfiler::GetTick(size_t index) const
+{
+    // Oldest tick first
+    return _history[(_historyHead + index) % _history.size()];
+}
+
+std::vector<uint64_t> TickProfiler::GetStageSamples(TickStage stage) const
+{
+    std::vector<uint64_t> samples;
+    samples.reserve(_history.size());
+    for (size_t i = 0; i < _history.size(); i++)
+    {
+        samples.push_back(GetTick(i).Stages[(size_t)stage]);
+    }
+    return samples;
+}
+
+std::vector<uint64_t> TickProfiler::GetTotalSamples() const
+{
+    std::vector<uint64_t> samples;
+    samples.reserve(_history.size());
+    for (size_t i = 0; i < _history.size(); i++)
+    {
+        samples.push_back(GetTick(i).Total);
+    }
+    return samples;
+}
+
+TickStageStatistics TickProfiler::CalculateStatistics(std::vector<uint64_t> samples)
+{
+    TickStageStatistics result;
+    if (samples.empty())
+    {
+        return result;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    uint64_t sum = 0;
+    for (auto sample : samples)
+    {
+        sum += sample;
+    }
+
+    // Nearest rank
+    auto percentile = [&samples](double p) {
+        auto rank = (size_t)std::ceil(p / 100.0 * samples.size());
+        return samples[std::max<size_t>(rank, 1) - 1];
+    };
+    result.Mean = sum / samples.size();
+    result.Median = percentile(50);
+    result.P95 = percentile(95);
+    result.P99 = percentile(99);
+    result.Max = samples.back();
+    return result;
+}
+
+TickStageStatistics TickProfiler::GetStageStatistics(TickStage stage) const
+{
+    return CalculateStatistics(GetStageSamples(stage));
+}
+
+TickStageStatistics TickProfiler::GetTotalStatistics() const
+{
+    return CalculateStatistics(GetTotalSamples());
+}
+
+const char* TickProfiler::GetStageName(TickStage stage)
+{
+    if ((size_t)stage >= NumStages)
+    {
+        return "total";
+    }
+    return TickStageNames[(size_t)stage];
+}
+
+std::string TickProfiler::GetSummary() const
+{
+    auto formatRow = [](const char* name, const TickStageStatistics& stats) {
+        return String::StdFormat(
+            "%-18s %10.1f %10.1f %10.1f %10.1f %10.1f\n", name, stats.Mean / 1000.0, stats.Median / 1000.0,
+            stats.P95 / 1000.0, stats.P99 / 1000.0, stats.Max / 1000.0);
+    };
+
+    std::string result = String::StdFormat(
+        "Last %zu of %llu ticks, in microseconds:\n", _history.size(), (unsigned long long)_totalTicks);
+    result += String::StdFormat("%-18s %10s %10s %10s %10s %10s\n", "stage", "mean", "p50", "p95", "p99", "max");
+    for (size_t i = 0; i < NumStages; i++)
+    {
+        auto stage = (TickStage)i;
+        result += formatRow(GetStageName(stage), GetStageStatistics(stage));
+    }
+    result += formatRow("total", GetTotalStatistics());
+    result.pop_back();
+    return result;
+}
+
+std::string TickProfiler::ToCsv() const
+{
+    std::string result = "tick";
+    for (size_t i = 0; i < NumStages; i++)
+    {
+        result += ',';
+        result += GetStageName((TickStage)i);
+    }
+    result += ",total\n";
+
+    uint64_t firstTick = _totalTicks - _history.size();
+    for (size_t i = 0; i < _history.size(); i++)
+    {
+        const auto& tick = GetTick(i);
+        result += std::to_string(firstTick + i);
+        for (auto ns : tick.Stages)
+        {
+            result += ',';
+            result += std::to_string(ns);
+        }
+        result += ',';
+        result += std::to_string(tick.Total);
+        result += '\n';
+    }
+    return result;
+}
+
+static json_t* StatisticsToJson(const TickStageStatistics& stats, const std::vector<uint64_t>& samples)
+{
+    json_t* jsonSamples = json_array();
+    for (auto sample : samples)
+    {
+        json_array_append_new(jsonSamples, json_integer((json_int_t)sample));
+    }
+
+    json_t* jsonStats = json_object();
+    json_object_set_new(jsonStats, "mean", json_integer((json_int_t)stats.Mean));
+    json_object_set_new(jsonStats, "p50", json_integer((json_int_t)stats.Median));
+    json_object_set_new(jsonStats, "p95", json_integer((json_int_t)stats.P95));
+    json_object_set_new(jsonStats, "p99", json_integer((json_int_t)stats.P99));
+    json_object_set_new(jsonStats, "max", json_integer((json_int_t)stats.Max));
+    json_object_set_new(jsonStats, "samples", jsonSamples);
+    return jsonStats;
+}
+
+void TickProfiler::WriteJson(const std::string& path) const
+{
+    json_t* jsonStages = json_object();
+    for (size_t i = 0; i < NumStages; i++)
+    {
+        auto stage = (TickStage)i;
+        auto samples = GetStageSamples(stage);
+        json_object_set_new(jsonStages, GetStageName(stage), StatisticsToJson(CalculateStatistics(samples), samples));
+    }
+    auto totalSamples = GetTotalSamples();
+
+    json_t* jsonProfile = json_object();
+    json_object_set_new(jsonProfile, "unit", json_string("ns"));
+    json_object_set_new(jsonProfile, "ticks", json_integer((json_int_t)_totalTicks));
+    json_object_set_new(jsonProfile, "first_tick", json_integer((json_int_t)(_totalTicks - _history.size())));
+    json_object_set_new(jsonProfile, "stages", jsonStages);
+    json_object_set_new(jsonProfile, "total", StatisticsToJson(CalculateStatistics(totalSamples), totalSamples));
+
+    try
+    {
+        Json::WriteToFile(path.c_str(), jsonProfile, JSON_INDENT(4) | JSON_PRESERVE_ORDER);
+    }
+    catch (...)
+    {
+        json_decref(jsonProfile);
+        throw;
+    }
+    json_decref(jsonProfile);
+}
+
+void TickProfiler::WriteToFile(const std::string& path) const
+{
+    if (String::EndsWith(path, ".json", true))
+    {
+        WriteJson(path);
+    }
+    else
+    {
+        auto csv = ToCsv();
+        File::WriteAllBytes(path, csv.data(), csv.size());
+    }
+}
@@ -0,0 +1,159 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "common.h"
+
+#include <array>
+#include <chrono>
+#include <string>
+#include <vector>
+
+enum class TickStage : uint8_t
+{
+    ReplayManager,
+    Network,
+    Date,
+    Scenario,
+    Climate,
+    MapTiles,
+    Peeps,
+    Vehicles,
+    MiscSprites,
+    Rides,
+    Park,
+    Research,
+    RideRatings,
+    RideMeasurements,
+    News,
+    MapAnimations,
+    Sounds,
+    EditorWindows,
+    GameActions,
+    NetworkFlush,
+    Count,
+};
+
+struct TickStageStatistics
+{
+    uint64_t Mean = 0;
+    uint64_t Median = 0;
+    uint64_t P95 = 0;
+    uint64_t P99 = 0;
+    uint64_t Max = 0;
+};
+
+/**
+ * Measures how long each stage of GameState::UpdateLogic takes. The time spent in every stage is kept for the most
+ * recent HistorySize ticks, all times are in nanoseconds. Does nothing but test a flag while disabled.
+ */
+class TickProfiler
+{
+public:
+    static constexpr size_t HistorySize = 1024;
+    static constexpr size_t NumStages = (size_t)TickStage::Count;
+
+    /**
+     * Times a whole tick, the time not covered by any stage is included in the tick's total.
+     */
+    class TickScope
+    {
+    public:
+        explicit TickScope(TickProfiler& profiler);
+        ~TickScope();
+
+        /**
+         * Drops the tick instead of recording it, used when the tick ends without updating the game.
+         */
+        void Discard()
+        {
+            _profiler = nullptr;
+        }
+
+    private:
+        TickProfiler* _profiler = nullptr;
+        std::chrono::steady_clock::time_point _start;
+    };
+
+    /**
+     * Adds the time until the end of the scope to a stage of the current tick.
+     */
+    class StageScope
+    {
+    public:
+        StageScope(TickProfiler& profiler, TickStage stage);
+        ~StageScope();
+
+    private:
+        TickProfiler* _profiler = nullptr;
+        TickStage _stage;
+        std::chrono::steady_clock::time_point _start;
+    };
+
+    bool IsEnabled() const
+    {
+        return _enabled;
+    }
+
+    void SetEnabled(bool enabled);
+    void Reset();
+
+    void AddTick(const std::array<uint64_t, NumStages>& stages, uint64_t total);
+
+    /**
+     * Returns the number of ticks currently held in the history.
+     */
+    size_t GetNumTicks() const;
+
+    /**
+     * Returns the number of ticks recorded since the last reset, including those no longer in the history.
+     */
+    uint64_t GetTotalTicks() const
+    {
+        return _totalTicks;
+    }
+
+    TickStageStatistics GetStageStatistics(TickStage stage) const;
+    TickStageStatistics GetTotalStatistics() const;
+
+    /**
+     * Returns a table of the statistics of every stage, in microseconds.
+     */
+    std::string GetSummary() const;
+
+    /**
+     * Writes the history to a file, as JSON if the path ends with .json and as CSV otherwise.
+     */
+    void WriteToFile(const std::string& path) const;
+
+    static const char* GetStageName(TickStage stage);
+
+private:
+    struct TickRecord
+    {
+        std::array<uint64_t, NumStages> Stages;
+        uint64_t Total;
+    };
+
+    static TickStageStatistics CalculateStatistics(std::vector<uint64_t> samples);
+    std::vector<uint64_t> GetStageSamples(TickStage stage) const;
+    std::vector<uint64_t> GetTotalSamples() const;
+    const TickRecord& GetTick(size_t index) const;
+    std::string ToCsv() const;
+    void WriteJson(const std::string& path) const;
+
+    bool _enabled = false;
+    std::array<uint64_t, NumStages> _currentStages{};
+    std::vector<TickRecord> _history;
+    size_t _historyHead = 0;
+    uint64_t _totalTicks = 0;
+};
+
+extern TickProfiler gTickProfiler;
@@ -16,6 +16,7 @@
 #include "../localisation/StringIds.h"
 #include "../management/Finance.h"
 #include "../world/Footpath.h"
+#include "../world/FootpathGraph.h"
 #include "../world/Location.hpp"
 #include "../world/Park.h"
 #include "../world/Surface.h"
@@ -122,6 +123,9 @@ public:
 
         gFootpathGroundFlags = 0;
 
+        // The path network changes, so corridors cached for the peep pathfinding have to be worked out again
+        footpath_graph_invalidate();
+
         // Force ride construction to recheck area
         _currentTrackSelectionFlags |= TRACK_SELECTION_FLAG_RECHECK;
 
@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include "../world/FootpathGraph.h"
 #include "../world/TileInspector.h"
 #include "GameAction.h"
 
@@ -83,6 +84,9 @@ public:
 
     GameActionResult::Ptr Execute() const override
     {
+        // The tile inspector can move or change elements directly, bypassing anything that keeps the footpath graph
+        // up to date.
+        footpath_graph_invalidate();
         return QueryExecute(true);
     }
 
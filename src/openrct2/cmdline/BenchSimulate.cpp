@@ -0,0 +1,213 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "CommandLine.hpp"
+
+#ifdef USE_BENCHMARK
+
+#    include "../Context.h"
+#    include "../GameState.h"
+#    include "../OpenRCT2.h"
+#    include "../TickProfiler.h"
+#    include "../core/String.hpp"
+#    include "../platform/Platform2.h"
+#    include "../platform/platform.h"
+
+#    include <atomic>
+#    include <benchmark/benchmark.h>
+#    include <cstdint>
+#    include <cstdlib>
+#    include <memory>
+#    include <new>
+#    include <string>
+#    include <vector>
+
+using namespace OpenRCT2;
+
+// Every allocation made through operator new is counted, so the benchmark can report allocations per tick.
+static std::atomic<uint64_t> _numAllocations = { 0 };
+
+void* operator new(size_t size)
+{
+    _numAllocations.fetch_add(1, std::memory_order_relaxed);
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+static constexpr uint32_t DefaultTicks = 1000;
+static constexpr uint32_t DefaultWarmupTicks = 100;
+
+static void BM_simulate(benchmark::State& state, const std::string& parkPath, uint32_t warmupTicks)
+{
+    gOpenRCT2Headless = true;
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        state.SkipWithError("Context initialization failed.");
+        return;
+    }
+    if (!context->LoadParkFromFile(parkPath))
+    {
+        state.SkipWithError("Failed to load park.");
+        return;
+    }
+
+    auto gameState = context->GetGameState();
+    for (uint32_t i = 0; i < warmupTicks; i++)
+    {
+        gameState->UpdateLogic();
+    }
+
+    gTickProfiler.Reset();
+    gTickProfiler.SetEnabled(true);
+    uint64_t allocationsBefore = _numAllocations;
+    for (auto _ : state)
+    {
+        gameState->UpdateLogic();
+    }
+    uint64_t numAllocations = _numAllocations - allocationsBefore;
+    gTickProfiler.SetEnabled(false);
+
+    auto numTicks = (double)state.iterations();
+    state.SetItemsProcessed(state.iterations());
+    state.counters["ticks/s"] = benchmark::Counter(numTicks, benchmark::Counter::kIsRate);
+    state.counters["allocs/tick"] = numAllocations / numTicks;
+    // The peak of the whole process, including any park benchmarked before this one.
+    state.counters["peak_rss_MiB"] = Platform::GetPeakMemoryUsage() / (1024.0 * 1024.0);
+    for (size_t i = 0; i < TickProfiler::NumStages; i++)
+    {
+        auto stage = (TickStage)i;
+        auto stats = gTickProfiler.GetStageStatistics(stage);
+        state.counters[std::string(TickProfiler::GetStageName(stage)) + "_us"] = stats.Mean / 1000.0;
+    }
+    auto totalStats = gTickProfiler.GetTotalStatistics();
+    state.counters["tick_p99_us"] = totalStats.P99 / 1000.0;
+}
+
+static int cmdline_for_bench_simulate(int argc, const char** argv)
+{
+    core_init();
+
+    uint32_t ticks = DefaultTicks;
+    uint32_t warmupTicks = DefaultWarmupTicks;
+    std::vector<std::string> parkPaths;
+
+    // Google benchmark does stuff to argv. It doesn't modify the pointees,
+    // but it wants to reorder the pointers, so present a copy of them.
+    std::vector<char*> argv_for_benchmark;
+
+    // argv[0] is expected to contain the binary name. It's only for logging purposes, don't bother.
+    argv_for_benchmark.push_back(nullptr);
+
+    // Extract file names and our own options from the argument list, anything else is a benchmark option.
+    for (int i = 0; i < argc; i++)
+    {
+        if (String::StartsWith(argv[i], "--ticks="))
+        {
+            ticks = atol(argv[i] + 8);
+        }
+        else if (String::StartsWith(argv[i], "--warmup="))
+        {
+            warmupTicks = atol(argv[i] + 9);
+        }
+        else if (platform_file_exists(argv[i]))
+        {
+            parkPaths.push_back(argv[i]);
+        }
+        else
+        {
+            argv_for_benchmark.push_back((char*)argv[i]);
+        }
+    }
+
+    if (ticks == 0)
+    {
+        log_error("The number of ticks must be greater than zero.");
+        return -1;
+    }
+
+    for (const auto& parkPath : parkPaths)
+    {
+        benchmark::RegisterBenchmark(parkPath.c_str(), BM_simulate, parkPath, warmupTicks)
+            ->Iterations(ticks)
+            ->Unit(benchmark::kMillisecond);
+    }
+
+    // Update argc with all the changes made
+    argc = (int)argv_for_benchmark.size();
+    ::benchmark::Initialize(&argc, &argv_for_benchmark[0]);
+    if (::benchmark::ReportUnrecognizedArguments(argc, &argv_for_benchmark[0]))
+        return -1;
+    ::benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
+
+static exitcode_t HandleBenchSimulate(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = (const char**)argEnumerator->GetArguments() + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    int32_t result = cmdline_for_bench_simulate(argc, argv);
+    if (result < 0)
+    {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+#else
+static exitcode_t HandleBenchSimulate(CommandLineArgEnumerator* argEnumerator)
+{
+    log_error("Sorry, Google benchmark not enabled in this build");
+    return EXITCODE_FAIL;
+}
+#endif // USE_BENCHMARK
+
+const CommandLineCommand CommandLine::BenchSimulateCommands[]{
+#ifdef USE_BENCHMARK
+    DefineCommand(
+        "",
+        "<file>... [--ticks=<ticks>] [--warmup=<ticks>] [--benchmark_repetitions=<num_repetitions>] "
+        "[--benchmark_report_aggregates_only={true|false}] [--benchmark_format=<console|json|csv>] "
+        "[--benchmark_out=<filename>] [--benchmark_out_format=<json|console|csv>] [--benchmark_color={auto|true|false}] "
+        "[--benchmark_counters_tabular={true|false}] [--v=<verbosity>]",
+        nullptr, HandleBenchSimulate),
+    CommandTableEnd
+#else
+    DefineCommand("", "*** SORRY NOT ENABLED IN THIS BUILD ***", nullptr, HandleBenchSimulate), CommandTableEnd
+#endif // USE_BENCHMARK
+};
@@ -30,47 +30,77 @@
 #    include "../world/Surface.h"
 
 #    include <benchmark/benchmark.h>
+#    include <chrono>
 #    include <cstdint>
 #    include <iterator>
+#    include <memory>
+#    include <string>
 #    include <vector>
 
-static void fixup_pointers(paint_session* s, size_t paint_session_entries, size_t paint_struct_entries, size_t quadrant_entries)
+// Turns the indices of a recording into pointers to its own paint structs and links them up with the session.
+static void fixup_pointers(RecordedPaintSession& recording, paint_session& session)
 {
-    for (size_t i = 0; i < paint_session_entries; i++)
+    const size_t nullIndex = std::size(recording.PaintStructs);
+    auto toPointer = [&recording, nullIndex](paint_struct* index) -> paint_struct* {
+        if ((uintptr_t)index == nullIndex)
+        {
+            return nullptr;
+        }
+        return &recording.PaintStructs[(uintptr_t)index];
+    };
+    for (auto& ps : recording.PaintStructs)
+    {
+        ps.next_quadrant_ps = toPointer(ps.next_quadrant_ps);
+    }
+    for (size_t i = 0; i < std::size(recording.Quadrants); i++)
+    {
+        session.Quadrants[i] = toPointer(recording.Quadrants[i]);
+    }
+    session.QuadrantBackIndex = recording.QuadrantBackIndex;
+    session.QuadrantFrontIndex = recording.QuadrantFrontIndex;
+    session.CurrentRotation = recording.CurrentRotation;
+}
+
+// Renders the view with every sort method and reports how many pixels differ from the quadrant sort.
+static void validate_sort_methods(rct_drawpixelinfo* dpi, rct_viewport* viewport)
+{
+    const size_t numPixels = (size_t)dpi->width * dpi->height;
+    std::vector<uint8_t> referencePixels(dpi->bits, dpi->bits + numPixels);
+
+    auto previousSortMethod = gPaintSortMethod;
+    for (auto sortMethod : { PaintSortMethod::Topological, PaintSortMethod::QuadrantSoA })
     {
-        for (size_t j = 0; j < paint_struct_entries; j++)
+        gPaintSortMethod = sortMethod;
+        viewport_render(dpi, viewport, 0, 0, viewport->width, viewport->height, nullptr);
+
+        size_t numMismatches = 0;
+        for (size_t i = 0; i < numPixels; i++)
         {
-            if (s[i].PaintStructs[j].basic.next_quadrant_ps == (paint_struct*)paint_struct_entries)
-            {
-                s[i].PaintStructs[j].basic.next_quadrant_ps = nullptr;
-            }
-            else
+            if (dpi->bits[i] != referencePixels[i])
             {
-                s[i].PaintStructs[j].basic.next_quadrant_ps = &s[i].PaintStructs
-                                                                   [(uintptr_t)s[i].PaintStructs[j].basic.next_quadrant_ps]
-                                                                       .basic;
+                numMismatches++;
             }
         }
-        for (size_t j = 0; j < quadrant_entries; j++)
+        if (numMismatches == 0)
         {
-            if (s[i].Quadrants[j] == (paint_struct*)quadrant_entries)
-            {
-                s[i].Quadrants[j] = nullptr;
-            }
-            else
-            {
-                s[i].Quadrants[j] = &s[i].PaintStructs[(size_t)s[i].Quadrants[j]].basic;
-            }
+            log_info("Sort method %u matches the quadrant sort.", (uint32_t)sortMethod);
+        }
+        else
+        {
+            log_warning(
+                "Sort method %u differs from the quadrant sort in %zu of %zu pixels.", (uint32_t)sortMethod, numMismatches,
+                numPixels);
         }
     }
+    gPaintSortMethod = previousSortMethod;
 }
 
-static std::vector<paint_session> extract_paint_session(const std::string parkFileName)
+static std::vector<RecordedPaintSession> extract_paint_session(const std::string parkFileName)
 {
     core_init();
     gOpenRCT2Headless = true;
     auto context = OpenRCT2::CreateContext();
-    std::vector<paint_session> sessions;
+    std::vector<RecordedPaintSession> sessions;
     log_info("Starting...");
     if (context->Initialise())
     {
@@ -128,6 +158,8 @@ static std::vector<paint_session> extract_paint_session(const std::string parkFi
         log_info("Obtaining sprite data...");
         viewport_render(&dpi, &viewport, 0, 0, viewport.width, viewport.height, &sessions);
 
+        validate_sort_methods(&dpi, &viewport);
+
         free(dpi.bits);
         drawing_engine_dispose();
     }
@@ -136,41 +168,59 @@ static std::vector<paint_session> extract_paint_session(const std::string parkFi
 }
 
 // This function is based on benchgfx_render_screenshots
-static void BM_paint_session_arrange(benchmark::State& state, const std::vector<paint_session> inputSessions)
+static void BM_paint_session_arrange(
+    benchmark::State& state, const std::vector<RecordedPaintSession> inputSessions, PaintSortMethod sortMethod)
 {
-    std::vector<paint_session> sessions = inputSessions;
-    // Fixing up the pointers continuously is wasteful. Fix it up once for `sessions` and store a copy.
+    std::vector<RecordedPaintSession> recordings = inputSessions;
+    std::vector<std::unique_ptr<paint_session>> sessions;
+    for (auto& recording : recordings)
+    {
+        sessions.push_back(std::make_unique<paint_session>());
+        fixup_pointers(recording, *sessions.back());
+    }
+
+    // Fixing up the pointers continuously is wasteful. Fix them up once and store a copy of the paint structs.
     // Keep in mind we need bit-exact copy, as the lists use pointers.
     // Once sorted, just restore the copy with the original fixed-up version.
-    paint_session* local_s = new paint_session[std::size(sessions)];
-    fixup_pointers(&sessions[0], std::size(sessions), std::size(local_s->PaintStructs), std::size(local_s->Quadrants));
-    std::copy_n(sessions.cbegin(), std::size(sessions), local_s);
+    std::vector<std::vector<paint_struct>> pristine;
+    size_t numPaintStructs = 0;
+    for (const auto& recording : recordings)
+    {
+        pristine.push_back(recording.PaintStructs);
+        numPaintStructs += std::size(recording.PaintStructs);
+    }
+    std::chrono::nanoseconds arrangeTime{ 0 };
     for (auto _ : state)
     {
         state.PauseTiming();
-        std::copy_n(local_s, std::size(sessions), sessions.begin());
+        for (size_t i = 0; i < std::size(recordings); i++)
+        {
+            std::copy(pristine[i].cbegin(), pristine[i].cend(), recordings[i].PaintStructs.begin());
+        }
         state.ResumeTiming();
-        paint_session_arrange(&sessions[0]);
+        auto startTime = std::chrono::high_resolution_clock::now();
+        for (auto& session : sessions)
+        {
+            paint_session_arrange(session.get(), sortMethod);
+        }
+        arrangeTime += std::chrono::high_resolution_clock::now() - startTime;
         benchmark::DoNotOptimize(sessions);
     }
     state.SetItemsProcessed(state.iterations() * std::size(sessions));
-    delete[] local_s;
+    if (numPaintStructs != 0)
+    {
+        state.counters["paint_structs"] = (double)numPaintStructs;
+        state.counters["ns/struct"] = (double)arrangeTime.count() / (state.iterations() * numPaintStructs);
+    }
 }
 
 static int cmdline_for_bench_sprite_sort(int argc, const char** argv)
 {
     {
         // Register some basic "baseline" benchmark
-        std::vector<paint_session> sessions(1);
-        for (auto& ps : sessions[0].PaintStructs)
-        {
-            ps.basic.next_quadrant_ps = (paint_struct*)(std::size(sessions[0].PaintStructs));
-        }
-        for (auto& quad : sessions[0].Quadrants)
-        {
-            quad = (paint_struct*)(std::size(sessions[0].Quadrants));
-        }
-        benchmark::RegisterBenchmark("baseline", BM_paint_session_arrange, sessions);
+        std::vector<RecordedPaintSession> sessions(1);
+        sessions[0].Quadrants.fill(nullptr);
+        benchmark::RegisterBenchmark("baseline", BM_paint_session_arrange, sessions, PaintSortMethod::Quadrant);
     }
 
     // Google benchmark does stuff to argv. It doesn't modify the pointees,
@@ -186,9 +236,17 @@ static int cmdline_for_bench_sprite_sort(int argc, const char** argv)
         if (platform_file_exists(argv[i]))
         {
             // Register benchmark for sv6 if valid
-            std::vector<paint_session> sessions = extract_paint_session(argv[i]);
+            std::vector<RecordedPaintSession> sessions = extract_paint_session(argv[i]);
             if (!sessions.empty())
-                benchmark::RegisterBenchmark(argv[i], BM_paint_session_arrange, sessions);
+            {
+                std::string name = argv[i];
+                benchmark::RegisterBenchmark(
+                    (name + "/quadrant").c_str(), BM_paint_session_arrange, sessions, PaintSortMethod::Quadrant);
+                benchmark::RegisterBenchmark(
+                    (name + "/topological").c_str(), BM_paint_session_arrange, sessions, PaintSortMethod::Topological);
+                benchmark::RegisterBenchmark(
+                    (name + "/quadrant_soa").c_str(), BM_paint_session_arrange, sessions, PaintSortMethod::QuadrantSoA);
+            }
         }
         else
         {
@@ -0,0 +1,134 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "CommandLine.hpp"
+
+#ifdef USE_BENCHMARK
+
+#    include "../core/JobPool.hpp"
+#    include "../core/TaskScheduler.h"
+
+#    include <benchmark/benchmark.h>
+#    include <cstdint>
+#    include <vector>
+
+// Simulates the cost of one small unit of work such as a single viewport column.
+static uint32_t bench_task_work(size_t index, int64_t workSize)
+{
+    uint32_t value = (uint32_t)index;
+    for (int64_t i = 0; i < workSize; i++)
+    {
+        value = value * 1664525 + 1013904223;
+    }
+    return value;
+}
+
+static void BM_job_pool(benchmark::State& state)
+{
+    const size_t numTasks = (size_t)state.range(0);
+    const int64_t workSize = state.range(1);
+    std::vector<uint32_t> results(numTasks);
+    JobPool pool;
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < numTasks; i++)
+        {
+            pool.AddTask([&results, i, workSize]() { results[i] = bench_task_work(i, workSize); });
+        }
+        pool.Join();
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.SetItemsProcessed(state.iterations() * numTasks);
+}
+
+static void BM_task_scheduler(benchmark::State& state)
+{
+    const size_t numTasks = (size_t)state.range(0);
+    const int64_t workSize = state.range(1);
+    std::vector<uint32_t> results(numTasks);
+    TaskScheduler scheduler;
+    for (auto _ : state)
+    {
+        scheduler.ParallelFor(numTasks, [&results, workSize](size_t i) { results[i] = bench_task_work(i, workSize); });
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.SetItemsProcessed(state.iterations() * numTasks);
+}
+
+// Task counts roughly match the number of 32px viewport columns at 1080p, 4K and 4K zoomed out.
+static void bench_task_args(benchmark::internal::Benchmark* b)
+{
+    for (int64_t numTasks : { 60, 120, 480 })
+    {
+        for (int64_t workSize : { 100, 10000 })
+        {
+            b->Args({ numTasks, workSize });
+        }
+    }
+    b->UseRealTime();
+}
+
+static int cmdline_for_bench_task_scheduler(int argc, const char** argv)
+{
+    benchmark::RegisterBenchmark("JobPool", BM_job_pool)->Apply(bench_task_args);
+    benchmark::RegisterBenchmark("TaskScheduler", BM_task_scheduler)->Apply(bench_task_args);
+
+    // Google benchmark does stuff to argv. It doesn't modify the pointees,
+    // but it wants to reorder the pointers, so present a copy of them.
+    std::vector<char*> argv_for_benchmark;
+
+    // argv[0] is expected to contain the binary name. It's only for logging purposes, don't bother.
+    argv_for_benchmark.push_back(nullptr);
+    for (int i = 0; i < argc; i++)
+    {
+        argv_for_benchmark.push_back((char*)argv[i]);
+    }
+
+    argc = (int)argv_for_benchmark.size();
+    ::benchmark::Initialize(&argc, &argv_for_benchmark[0]);
+    if (::benchmark::ReportUnrecognizedArguments(argc, &argv_for_benchmark[0]))
+        return -1;
+    ::benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
+
+static exitcode_t HandleBenchTaskScheduler(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = (const char**)argEnumerator->GetArguments() + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    int32_t result = cmdline_for_bench_task_scheduler(argc, argv);
+    if (result < 0)
+    {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+#else
+static exitcode_t HandleBenchTaskScheduler(CommandLineArgEnumerator* argEnumerator)
+{
+    log_error("Sorry, Google benchmark not enabled in this build");
+    return EXITCODE_FAIL;
+}
+#endif // USE_BENCHMARK
+
+const CommandLineCommand CommandLine::BenchTaskSchedulerCommands[]{
+#ifdef USE_BENCHMARK
+    DefineCommand(
+        "",
+        "[--benchmark_list_tests={true|false}] [--benchmark_filter=<regex>] [--benchmark_min_time=<min_time>] "
+        "[--benchmark_repetitions=<num_repetitions>] [--benchmark_report_aggregates_only={true|false}] "
+        "[--benchmark_format=<console|json|csv>] [--benchmark_out=<filename>] [--benchmark_out_format=<json|console|csv>] "
+        "[--benchmark_color={auto|true|false}] [--benchmark_counters_tabular={true|false}] [--v=<verbosity>]",
+        nullptr, HandleBenchTaskScheduler),
+    CommandTableEnd
+#else
+    DefineCommand("", "*** SORRY NOT ENABLED IN THIS BUILD ***", nullptr, HandleBenchTaskScheduler), CommandTableEnd
+#endif // USE_BENCHMARK
+};
@@ -11,6 +11,7 @@
 #include "../Game.h"
 #include "../GameState.h"
 #include "../OpenRCT2.h"
+#include "../TickProfiler.h"
 #include "../core/Console.hpp"
 #include "../network/network.h"
 #include "../platform/platform.h"
@@ -22,11 +23,26 @@
 
 using namespace OpenRCT2;
 
+static bool _profile = false;
+static utf8* _profileOutput = nullptr;
+
+// clang-format off
+static constexpr const CommandLineOptionDefinition SimulateOptions[]
+{
+    { CMDLINE_TYPE_SWITCH, &_profile,       NAC, "profile",        "print the time spent in each stage of the game update" },
+    { CMDLINE_TYPE_STRING, &_profileOutput, NAC, "profile-output", "write the tick profile to a .csv or .json file"         },
+    OptionTableEnd
+};
+
 static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator);
 
-const CommandLineCommand CommandLine::SimulateCommands[]{ // Main commands
-                                                          DefineCommand("", "<ticks>", nullptr, HandleSimulate), CommandTableEnd
+const CommandLineCommand CommandLine::SimulateCommands[]
+{
+    // Main commands
+    DefineCommand("", "<ticks>", SimulateOptions, HandleSimulate),
+    CommandTableEnd
 };
+// clang-format on
 
 static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator)
 {
@@ -58,12 +74,37 @@ static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator)
             return EXITCODE_FAIL;
         }
 
+        bool profile = _profile || _profileOutput != nullptr;
+        if (profile)
+        {
+            gTickProfiler.Reset();
+            gTickProfiler.SetEnabled(true);
+        }
+
         Console::WriteLine("Running %d ticks...", ticks);
         for (uint32_t i = 0; i < ticks; i++)
         {
             context->GetGameState()->UpdateLogic();
         }
         Console::WriteLine("Completed: %s", sprite_checksum().ToString().c_str());
+
+        if (profile)
+        {
+            gTickProfiler.SetEnabled(false);
+            Console::WriteLine("%s", gTickProfiler.GetSummary().c_str());
+            if (_profileOutput != nullptr)
+            {
+                try
+                {
+                    gTickProfiler.WriteToFile(_profileOutput);
+                }
+                catch (const std::exception& e)
+                {
+                    Console::Error::WriteLine("Unable to write tick profile: %s", e.what());
+                    return EXITCODE_FAIL;
+                }
+            }
+        }
     }
     else
     {
@@ -14,11 +14,10 @@
 #include "File.h"
 #include "FileScanner.h"
 #include "FileStream.hpp"
-#include "JobPool.hpp"
 #include "Path.hpp"
+#include "TaskScheduler.h"
 
 #include <chrono>
-#include <list>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -205,37 +204,26 @@ private:
         const size_t totalCount = scanResult.Files.size();
         if (totalCount > 0)
         {
-            JobPool jobPool;
-            std::mutex printLock; // For verbose prints.
+            TaskScheduler scheduler;
+            std::mutex printLock; // For progress and verbose prints.
 
-            std::list<std::vector<TItem>> containers;
+            const size_t stepSize = 100; // Handpicked, seems to work well with 4/8 cores.
 
-            size_t stepSize = 100; // Handpicked, seems to work well with 4/8 cores.
+            std::vector<std::vector<TItem>> containers((totalCount + stepSize - 1) / stepSize);
 
             std::atomic<size_t> processed = ATOMIC_VAR_INIT(0);
 
             auto reportProgress = [&]() {
                 const size_t completed = processed;
+                std::lock_guard<std::mutex> lock(printLock);
                 Console::WriteFormat("File %5zu of %zu, done %3d%%\r", completed, totalCount, completed * 100 / totalCount);
             };
 
-            for (size_t rangeStart = 0; rangeStart < totalCount; rangeStart += stepSize)
-            {
-                if (rangeStart + stepSize > totalCount)
-                {
-                    stepSize = totalCount - rangeStart;
-                }
-
-                auto& items = containers.emplace_back();
-
-                jobPool.AddTask(std::bind(
-                    &FileIndex<TItem>::BuildRange, this, language, std::cref(scanResult), rangeStart, rangeStart + stepSize,
-                    std::ref(items), std::ref(processed), std::ref(printLock)));
-
+            scheduler.ParallelForRange(totalCount, stepSize, [&](size_t rangeStart, size_t rangeEnd) {
+                BuildRange(
+                    language, scanResult, rangeStart, rangeEnd, containers[rangeStart / stepSize], processed, printLock);
                 reportProgress();
-            }
-
-            jobPool.Join(reportProgress);
+            });
 
             for (auto&& itr : containers)
             {
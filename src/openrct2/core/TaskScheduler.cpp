@@ -0,0 +1,264 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TaskScheduler.h"
+
+#include <algorithm>
+#include <cassert>
+
+// Number of failed attempts to find work before a worker goes to sleep.
+static constexpr int32_t WORKER_SPIN_COUNT = 64;
+
+struct WorkerState
+{
+    TaskScheduler* Scheduler;
+    size_t QueueIndex;
+};
+
+static thread_local WorkerState _workerState = { nullptr, 0 };
+
+bool TaskQueue::Push(TaskJob* job)
+{
+    auto bottom = _bottom.load(std::memory_order_relaxed);
+    auto top = _top.load(std::memory_order_acquire);
+    if (bottom - top >= (int64_t)Capacity)
+    {
+        return false;
+    }
+    _items[bottom & Mask].store(job, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    _bottom.store(bottom + 1, std::memory_order_relaxed);
+    return true;
+}
+
+TaskJob* TaskQueue::Pop()
+{
+    auto bottom = _bottom.load(std::memory_order_relaxed) - 1;
+    _bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto top = _top.load(std::memory_order_relaxed);
+    if (top > bottom)
+    {
+        // Queue was already empty.
+        _bottom.store(bottom + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    auto job = _items[bottom & Mask].load(std::memory_order_relaxed);
+    if (top == bottom)
+    {
+        // Last item, race against any thieves for it.
+        if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            job = nullptr;
+        }
+        _bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return job;
+}
+
+TaskJob* TaskQueue::Steal()
+{
+    auto top = _top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto bottom = _bottom.load(std::memory_order_acquire);
+    if (top >= bottom)
+    {
+        return nullptr;
+    }
+
+    auto job = _items[top & Mask].load(std::memory_order_relaxed);
+    if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+    {
+        return nullptr;
+    }
+    return job;
+}
+
+TaskScheduler::TaskScheduler(size_t maxThreads)
+{
+    size_t concurrency = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    concurrency = std::clamp<size_t>(maxThreads, 1, concurrency);
+
+    // Queue 0 belongs to whichever external thread is currently submitting work.
+    for (size_t n = 0; n < concurrency; n++)
+    {
+        _queues.push_back(std::make_unique<TaskQueue>());
+    }
+    for (size_t n = 1; n < concurrency; n++)
+    {
+        _threads.emplace_back(&TaskScheduler::ProcessQueue, this, n);
+    }
+}
+
+TaskScheduler::~TaskScheduler()
+{
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _shouldStop = true;
+        _sleepCondition.notify_all();
+    }
+
+    for (auto&& th : _threads)
+    {
+        assert(th.joinable() != false);
+        th.join();
+    }
+}
+
+void TaskScheduler::Run(size_t count, size_t grainSize, TaskJob::TaskFunction fn, void* context)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    TaskJob job;
+    job.Function = fn;
+    job.Context = context;
+    job.Count = count;
+    job.GrainSize = std::max<size_t>(grainSize, 1);
+
+    if (_workerState.Scheduler == this)
+    {
+        // Nested call from a worker or from within a job submitted by this thread.
+        RunOnQueue(_workerState.QueueIndex, job);
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock(_externalMutex);
+        auto previousState = _workerState;
+        _workerState = { this, 0 };
+        RunOnQueue(0, job);
+        _workerState = previousState;
+    }
+}
+
+void TaskScheduler::RunOnQueue(size_t queueIndex, TaskJob& job)
+{
+    // Offer the job to as many threads as could usefully take part in it.
+    auto& queue = *_queues[queueIndex];
+    size_t numChunks = (job.Count + job.GrainSize - 1) / job.GrainSize;
+    size_t numHelpers = std::min(numChunks - 1, _threads.size());
+    size_t numPushed = 0;
+    for (; numPushed < numHelpers; numPushed++)
+    {
+        job.Helpers.fetch_add(1, std::memory_order_relaxed);
+        if (!queue.Push(&job))
+        {
+            job.Helpers.fetch_sub(1, std::memory_order_relaxed);
+            break;
+        }
+    }
+    if (numPushed != 0)
+    {
+        WakeWorkers();
+    }
+
+    ExecuteChunks(job);
+
+    // The job lives on our stack, so every reference handed out must be returned before leaving. Run other
+    // work meanwhile, this also drains our own references that nobody stole.
+    while (job.Helpers.load(std::memory_order_acquire) != 0)
+    {
+        auto otherJob = FindWork(queueIndex);
+        if (otherJob != nullptr)
+        {
+            Execute(otherJob);
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void TaskScheduler::ExecuteChunks(TaskJob& job)
+{
+    while (true)
+    {
+        size_t begin = job.Next.fetch_add(job.GrainSize, std::memory_order_relaxed);
+        if (begin >= job.Count)
+        {
+            break;
+        }
+        size_t end = std::min(begin + job.GrainSize, job.Count);
+        job.Function(job.Context, begin, end);
+    }
+}
+
+void TaskScheduler::Execute(TaskJob* job)
+{
+    ExecuteChunks(*job);
+
+    // Must be the last access to the job, the owner may return as soon as it sees zero.
+    job->Helpers.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+TaskJob* TaskScheduler::FindWork(size_t queueIndex)
+{
+    auto job = _queues[queueIndex]->Pop();
+    if (job != nullptr)
+    {
+        return job;
+    }
+
+    size_t numQueues = _queues.size();
+    for (size_t i = 1; i < numQueues; i++)
+    {
+        job = _queues[(queueIndex + i) % numQueues]->Steal();
+        if (job != nullptr)
+        {
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+void TaskScheduler::WakeWorkers()
+{
+    _epoch.fetch_add(1);
+    if (_sleeping.load() != 0)
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _sleepCondition.notify_all();
+    }
+}
+
+void TaskScheduler::ProcessQueue(size_t queueIndex)
+{
+    _workerState = { this, queueIndex };
+
+    int32_t spinCount = 0;
+    while (!_shouldStop)
+    {
+        auto epoch = _epoch.load();
+        auto job = FindWork(queueIndex);
+        if (job != nullptr)
+        {
+            Execute(job);
+            spinCount = 0;
+            continue;
+        }
+
+        if (spinCount < WORKER_SPIN_COUNT)
+        {
+            spinCount++;
+            std::this_thread::yield();
+            continue;
+        }
+
+        // Wait until new work has been published since we last looked.
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        _sleeping++;
+        _sleepCondition.wait(lock, [this, epoch]() { return _shouldStop || _epoch.load() != epoch; });
+        _sleeping--;
+        spinCount = 0;
+    }
+}
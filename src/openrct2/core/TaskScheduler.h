@@ -0,0 +1,129 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * A batch of work items described by a plain function pointer and context. Jobs live on the stack of the thread
+ * that submitted them, so scheduling never allocates. Idle threads join a job by taking a reference to it from a
+ * work-stealing queue and then claim chunks of the index range until it is exhausted.
+ */
+struct TaskJob
+{
+    using TaskFunction = void (*)(void* context, size_t begin, size_t end);
+
+    TaskFunction Function = nullptr;
+    void* Context = nullptr;
+    size_t Count = 0;
+    size_t GrainSize = 1;
+    std::atomic<size_t> Next = { 0 };
+    std::atomic<size_t> Helpers = { 0 };
+};
+
+/**
+ * Chase-Lev work-stealing deque of job references. Push and Pop may only be called by the owning thread,
+ * Steal may be called by any thread. The capacity is fixed; Push fails instead of growing.
+ */
+class TaskQueue
+{
+public:
+    static constexpr size_t Capacity = 256;
+
+    bool Push(TaskJob* job);
+    TaskJob* Pop();
+    TaskJob* Steal();
+
+private:
+    static constexpr size_t Mask = Capacity - 1;
+    static_assert((Capacity & Mask) == 0, "Capacity must be a power of two");
+
+    alignas(64) std::atomic<int64_t> _top = { 0 };
+    alignas(64) std::atomic<int64_t> _bottom = { 0 };
+    std::array<std::atomic<TaskJob*>, Capacity> _items{};
+};
+
+/**
+ * Work-stealing scheduler with one queue per worker thread plus one for the submitting thread. Replaces the
+ * single mutex / condition variable design of JobPool for fine-grained parallel loops.
+ */
+class TaskScheduler
+{
+private:
+    std::vector<std::thread> _threads;
+    std::vector<std::unique_ptr<TaskQueue>> _queues;
+    std::mutex _externalMutex;
+
+    std::atomic_bool _shouldStop = { false };
+    std::atomic<uint32_t> _epoch = { 0 };
+    std::atomic<uint32_t> _sleeping = { 0 };
+    std::mutex _sleepMutex;
+    std::condition_variable _sleepCondition;
+
+public:
+    explicit TaskScheduler(size_t maxThreads = 255);
+    ~TaskScheduler();
+
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    /**
+     * Returns the number of threads that execute work, including the submitting thread.
+     */
+    size_t GetConcurrency() const
+    {
+        return _threads.size() + 1;
+    }
+
+    /**
+     * Runs fn(begin, end) over [0, count) in chunks of at most grainSize items and returns once every chunk has
+     * completed. The calling thread takes part in the work. May be nested from within a running task.
+     */
+    template<typename TFn> void ParallelForRange(size_t count, size_t grainSize, TFn&& fn)
+    {
+        using TFnType = std::remove_reference_t<TFn>;
+        Run(
+            count, grainSize,
+            [](void* context, size_t begin, size_t end) { (*static_cast<TFnType*>(context))(begin, end); },
+            const_cast<void*>(static_cast<const void*>(&fn)));
+    }
+
+    /**
+     * Runs fn(index) for every index in [0, count).
+     */
+    template<typename TFn> void ParallelFor(size_t count, TFn&& fn, size_t grainSize = 1)
+    {
+        ParallelForRange(count, grainSize, [&fn](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++)
+            {
+                fn(i);
+            }
+        });
+    }
+
+    void Run(size_t count, size_t grainSize, TaskJob::TaskFunction fn, void* context);
+
+private:
+    void RunOnQueue(size_t queueIndex, TaskJob& job);
+    void ExecuteChunks(TaskJob& job);
+    void Execute(TaskJob* job);
+    TaskJob* FindWork(size_t queueIndex);
+    void WakeWorkers();
+    void ProcessQueue(size_t queueIndex);
+};
@@ -14,6 +14,7 @@
 #include "../common.h"
 #include "../core/Guard.hpp"
 #include "../object/Object.h"
+#include "../paint/PaintTileCache.h"
 #include "../platform/platform.h"
 #include "../sprites.h"
 #include "../util/Util.h"
@@ -35,11 +36,12 @@ int32_t gPickupPeepY;
 
 /**
  * 12 elements from 0xF3 are the peep top colour, 12 elements from 0xCA are peep trouser colour
+ * Thread local as the palette is patched while drawing sprites, which can happen on several threads at once.
  *
  * rct2: 0x0009ABE0C
  */
 // clang-format off
-uint8_t gPeepPalette[256] = {
+thread_local uint8_t gPeepPalette[256] = {
     0x00, 0xF3, 0xF4, 0xF5, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
     0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F,
     0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F,
@@ -59,7 +61,7 @@ uint8_t gPeepPalette[256] = {
 };
 
 /** rct2: 0x009ABF0C */
-uint8_t gOtherPalette[256] = {
+thread_local uint8_t gOtherPalette[256] = {
     0x00, 0xF3, 0xF4, 0xF5, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
     0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F,
     0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F,
@@ -601,6 +603,8 @@ void load_palette()
  */
 void gfx_invalidate_screen()
 {
+    // Anything may have changed, so don't trust any cached tile either.
+    gPaintTileCache.Flush();
     gfx_set_dirty_blocks(0, 0, context_get_width(), context_get_height());
 }
 
@@ -427,8 +427,8 @@ extern uint8_t gGamePalette[256 * 4];
 extern uint32_t gPaletteEffectFrame;
 extern const FILTER_PALETTE_ID GlassPaletteIds[COLOUR_COUNT];
 extern const uint16_t palette_to_g1_offset[];
-extern uint8_t gPeepPalette[256];
-extern uint8_t gOtherPalette[256];
+extern thread_local uint8_t gPeepPalette[256];
+extern thread_local uint8_t gOtherPalette[256];
 extern uint8_t text_palette[];
 extern const translucent_window_palette TranslucentWindowPalettes[COLOUR_COUNT];
 
@@ -10,6 +10,7 @@
 #include "NewDrawing.h"
 
 #include "../Context.h"
+#include "../Game.h"
 #include "../config/Config.h"
 #include "../drawing/Drawing.h"
 #include "../interface/Screenshot.h"
@@ -157,6 +158,12 @@ void drawing_engine_set_vsync(bool vsync)
 
 void gfx_set_dirty_blocks(int16_t left, int16_t top, int16_t right, int16_t bottom)
 {
+    if (gInTurboUpdate)
+    {
+        // The whole screen is invalidated once the turbo frame is done
+        return;
+    }
+
     auto drawingEngine = GetDrawingEngine();
     if (drawingEngine != nullptr)
     {
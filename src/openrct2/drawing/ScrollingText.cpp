@@ -1448,6 +1448,9 @@ int32_t scrolling_text_setup(
 
     assert(scrollingMode < MAX_SCROLLING_TEXT_MODES);
 
+    // The image is regenerated every frame as the text scrolls.
+    paint_session_set_tile_volatile(session);
+
     rct_drawpixelinfo* dpi = &session->DPI;
 
     if (dpi->zoom_level != 0)
@@ -120,7 +120,6 @@ void X8RainDrawer::Restore()
 
 X8DrawingEngine::X8DrawingEngine([[maybe_unused]] const std::shared_ptr<Ui::IUiContext>& uiContext)
 {
-    _drawingContext = new X8DrawingContext(this);
     _bitsDPI.DrawingEngine = this;
 #ifdef __ENABLE_LIGHTFX__
     lightfx_set_available(true);
@@ -130,7 +129,6 @@ X8DrawingEngine::X8DrawingEngine([[maybe_unused]] const std::shared_ptr<Ui::IUiC
 
 X8DrawingEngine::~X8DrawingEngine()
 {
-    delete _drawingContext;
     delete[] _dirtyGrid.Blocks;
     delete[] _bits;
 }
@@ -274,8 +272,11 @@ std::string X8DrawingEngine::Screenshot()
 
 IDrawingContext* X8DrawingEngine::GetDrawingContext(rct_drawpixelinfo* dpi)
 {
-    _drawingContext->SetDPI(dpi);
-    return _drawingContext;
+    // A context only holds the target DPI, so give each thread its own to allow viewport columns to be drawn in parallel.
+    thread_local X8DrawingContext drawingContext(nullptr);
+    drawingContext = X8DrawingContext(this);
+    drawingContext.SetDPI(dpi);
+    return &drawingContext;
 }
 
 rct_drawpixelinfo* X8DrawingEngine::GetDrawingPixelInfo()
@@ -285,7 +286,7 @@ rct_drawpixelinfo* X8DrawingEngine::GetDrawingPixelInfo()
 
 DRAWING_ENGINE_FLAGS X8DrawingEngine::GetFlags()
 {
-    return DEF_DIRTY_OPTIMISATIONS;
+    return (DRAWING_ENGINE_FLAGS)(DEF_DIRTY_OPTIMISATIONS | DEF_PARALLEL_DRAWING);
 }
 
 void X8DrawingEngine::InvalidateImage([[maybe_unused]] uint32_t image)
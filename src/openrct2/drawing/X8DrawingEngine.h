@@ -81,7 +81,6 @@ namespace OpenRCT2
 #endif
 
             X8RainDrawer _rainDrawer;
-            X8DrawingContext* _drawingContext;
 
         public:
             explicit X8DrawingEngine(const std::shared_ptr<Ui::IUiContext>& uiContext);
@@ -14,6 +14,7 @@
 #include "../Game.h"
 #include "../OpenRCT2.h"
 #include "../ReplayManager.h"
+#include "../TickProfiler.h"
 #include "../Version.h"
 #include "../actions/ClimateSetAction.hpp"
 #include "../actions/RideSetPriceAction.hpp"
@@ -36,12 +37,16 @@
 #include "../object/ObjectList.h"
 #include "../object/ObjectManager.h"
 #include "../object/ObjectRepository.h"
+#include "../paint/PaintTileCache.h"
+#include "../paint/Painter.h"
+#include "../peep/GuestDistanceField.h"
 #include "../peep/Staff.h"
 #include "../ride/Ride.h"
 #include "../ride/RideData.h"
 #include "../util/Util.h"
 #include "../windows/Intent.h"
 #include "../world/Climate.h"
+#include "../world/FootpathGraph.h"
 #include "../world/Park.h"
 #include "../world/Scenery.h"
 #include "../world/Sprite.h"
@@ -638,6 +643,14 @@ static int32_t cc_get(InteractiveConsole& console, const arguments_t& argv)
         {
             console.WriteFormatLine("game_speed %d", gGameSpeed);
         }
+        else if (argv[0] == "turbo_mode")
+        {
+            console.WriteFormatLine("turbo_mode %d", gTurboMode);
+        }
+        else if (argv[0] == "turbo_render_interval")
+        {
+            console.WriteFormatLine("turbo_render_interval %u", gTurboModeRenderInterval);
+        }
         else if (argv[0] == "console_small_font")
         {
             console.WriteFormatLine("console_small_font %d", gConfigInterface.console_small_font);
@@ -695,6 +708,43 @@ static int32_t cc_get(InteractiveConsole& console, const arguments_t& argv)
         {
             console.WriteFormatLine("current_rotation %d", get_current_rotation());
         }
+        else if (argv[0] == "paint_verify_parallel_draw")
+        {
+            console.WriteFormatLine("paint_verify_parallel_draw %d", gPaintVerifyParallelDraw);
+        }
+        else if (argv[0] == "paint_sort_method")
+        {
+            console.WriteFormatLine("paint_sort_method %d", (int32_t)gPaintSortMethod);
+        }
+        else if (argv[0] == "paint_entries_peak")
+        {
+            auto painter = OpenRCT2::GetContext()->GetPainter();
+            console.WriteFormatLine(
+                "paint_entries_peak %zu (%zu KiB allocated)", painter->GetPeakPaintEntries(),
+                painter->GetPaintEntryMemoryUsage() / 1024);
+        }
+        else if (argv[0] == "paint_tile_cache")
+        {
+            console.WriteFormatLine(
+                "paint_tile_cache %d (%llu hits, %llu misses)", gPaintTileCache.IsEnabled(),
+                (unsigned long long)gPaintTileCache.GetNumHits(), (unsigned long long)gPaintTileCache.GetNumMisses());
+        }
+        else if (argv[0] == "tick_profiler")
+        {
+            console.WriteFormatLine(
+                "tick_profiler %d (%llu ticks)", gTickProfiler.IsEnabled(), (unsigned long long)gTickProfiler.GetTotalTicks());
+        }
+        else if (argv[0] == "footpath_graph")
+        {
+            console.WriteFormatLine(
+                "footpath_graph %d (%zu segments)", gFootpathGraph.IsEnabled(), gFootpathGraph.GetNumSegments());
+        }
+        else if (argv[0] == "guest_distance_fields")
+        {
+            console.WriteFormatLine(
+                "guest_distance_fields %d (%zu fields, %zu paths)", gGuestDistanceFields.IsEnabled(),
+                gGuestDistanceFields.GetNumFields(), gGuestDistanceFields.GetNumNodes());
+        }
 #ifndef NO_TTF
         else if (argv[0] == "enable_hinting")
         {
@@ -894,6 +944,20 @@ static int32_t cc_set(InteractiveConsole& console, const arguments_t& argv)
             gGameSpeed = std::clamp(int_val[0], 1, 8);
             console.Execute("get game_speed");
         }
+        else if (argv[0] == "turbo_mode" && invalidArguments(&invalidArgs, int_valid[0]))
+        {
+            gTurboMode = (int_val[0] != 0);
+            if (gTurboMode && network_get_mode() != NETWORK_MODE_NONE)
+            {
+                console.WriteLineWarning("Turbo mode has no effect in multiplayer.");
+            }
+            console.Execute("get turbo_mode");
+        }
+        else if (argv[0] == "turbo_render_interval" && invalidArguments(&invalidArgs, int_valid[0]))
+        {
+            gTurboModeRenderInterval = std::clamp(int_val[0], 1, 60000);
+            console.Execute("get turbo_render_interval");
+        }
         else if (argv[0] == "console_small_font" && invalidArguments(&invalidArgs, int_valid[0]))
         {
             gConfigInterface.console_small_font = (int_val[0] != 0);
@@ -1009,6 +1073,40 @@ static int32_t cc_set(InteractiveConsole& console, const arguments_t& argv)
             }
             console.Execute("get current_rotation");
         }
+        else if (argv[0] == "paint_verify_parallel_draw" && invalidArguments(&invalidArgs, int_valid[0]))
+        {
+            gPaintVerifyParallelDraw = (int_val[0] != 0);
+            console.Execute("get paint_verify_parallel_draw");
+        }
+        else if (
+            argv[0] == "paint_sort_method"
+            && invalidArguments(
+                &invalidArgs, int_valid[0] && int_val[0] >= 0 && int_val[0] < (int32_t)PaintSortMethod::Count))
+        {
+            gPaintSortMethod = (PaintSortMethod)int_val[0];
+            console.Execute("get paint_sort_method");
+        }
+        else if (argv[0] == "paint_tile_cache" && invalidArguments(&invalidArgs, int_valid[0]))
+        {
+            gPaintTileCache.SetEnabled(int_val[0] != 0);
+            gfx_invalidate_screen();
+            console.Execute("get paint_tile_cache");
+        }
+        else if (argv[0] == "tick_profiler" && invalidArguments(&invalidArgs, int_valid[0]))
+        {
+            gTickProfiler.SetEnabled(int_val[0] != 0);
+            console.Execute("get tick_profiler");
+        }
+        else if (argv[0] == "footpath_graph" && invalidArguments(&invalidArgs, int_valid[0]))
+        {
+            gFootpathGraph.SetEnabled(int_val[0] != 0);
+            console.Execute("get footpath_graph");
+        }
+        else if (argv[0] == "guest_distance_fields" && invalidArguments(&invalidArgs, int_valid[0]))
+        {
+            gGuestDistanceFields.SetEnabled(int_val[0] != 0);
+            console.Execute("get guest_distance_fields");
+        }
 #ifndef NO_TTF
         else if (argv[0] == "enable_hinting" && invalidArguments(&invalidArgs, int_valid[0]))
         {
@@ -1349,6 +1447,40 @@ static int32_t cc_say(InteractiveConsole& console, const arguments_t& argv)
     }
 }
 
+static int32_t cc_tick_profile(InteractiveConsole& console, const arguments_t& argv)
+{
+    if (argv.empty())
+    {
+        if (!gTickProfiler.IsEnabled())
+        {
+            console.WriteLine("The tick profiler is disabled, use \"set tick_profiler 1\" to enable it.");
+        }
+        console.WriteLine(gTickProfiler.GetSummary());
+    }
+    else if (argv[0] == "reset")
+    {
+        gTickProfiler.Reset();
+        console.WriteLine("Tick profile cleared.");
+    }
+    else if (argv[0] == "dump" && argv.size() >= 2)
+    {
+        try
+        {
+            gTickProfiler.WriteToFile(argv[1]);
+            console.WriteFormatLine("Tick profile written to %s", argv[1].c_str());
+        }
+        catch (const std::exception& e)
+        {
+            console.WriteLineError(e.what());
+        }
+    }
+    else
+    {
+        console.WriteLineError("Usage: tick_profile [reset | dump <path>]");
+    }
+    return 0;
+}
+
 static int32_t cc_replay_startrecord(InteractiveConsole& console, const arguments_t& argv)
 {
     if (network_get_mode() != NETWORK_MODE_NONE)
@@ -1633,6 +1765,8 @@ static constexpr const utf8* console_variable_table[] = {
     "park_open",
     "climate",
     "game_speed",
+    "turbo_mode",
+    "turbo_render_interval",
     "console_small_font",
     "location",
     "window_scale",
@@ -1643,6 +1777,13 @@ static constexpr const utf8* console_variable_table[] = {
     "cheat_disable_clearance_checks",
     "cheat_disable_support_limits",
     "current_rotation",
+    "paint_verify_parallel_draw",
+    "paint_sort_method",
+    "paint_entries_peak",
+    "paint_tile_cache",
+    "tick_profiler",
+    "footpath_graph",
+    "guest_distance_fields",
 };
 static constexpr const utf8* console_window_table[] = {
     "object_selection",
@@ -1680,6 +1821,7 @@ static constexpr const console_command console_command_table[] = {
     { "show_limits", cc_show_limits, "Shows the map data counts and limits.", "show_limits" },
     { "staff", cc_staff, "Staff management.", "staff <subcommand>" },
     { "terminate", cc_terminate, "Calls std::terminate(), for testing purposes only.", "terminate" },
+    { "tick_profile", cc_tick_profile, "Shows the time spent in each stage of the game update. A path ending in .json is written as JSON, anything else as CSV.", "tick_profile [reset | dump <path>]" },
     { "twitch", cc_twitch, "Twitch API", "twitch" },
     { "variables", cc_variables, "Lists all the variables that can be used with get and sometimes set.", "variables" },
     { "windows", cc_windows, "Lists all the windows that can be opened.", "windows" },
@@ -15,9 +15,11 @@
 #include "../OpenRCT2.h"
 #include "../config/Config.h"
 #include "../core/Guard.hpp"
-#include "../core/JobPool.hpp"
+#include "../core/TaskScheduler.h"
 #include "../drawing/Drawing.h"
+#include "../drawing/IDrawingEngine.h"
 #include "../paint/Paint.h"
+#include "../paint/PaintTileCache.h"
 #include "../peep/Staff.h"
 #include "../ride/Ride.h"
 #include "../ride/TrackDesign.h"
@@ -43,7 +45,8 @@ uint8_t gShowConstuctionRightsRefCount;
 rct_viewport g_viewport_list[MAX_VIEWPORT_COUNT];
 rct_viewport* g_music_tracking_viewport;
 
-static std::unique_ptr<JobPool> _paintJobs;
+static std::unique_ptr<TaskScheduler> _paintJobs;
+bool gPaintVerifyParallelDraw;
 
 int16_t gSavedViewX;
 int16_t gSavedViewY;
@@ -787,7 +790,7 @@ void viewport_update_smart_vehicle_follow(rct_window* window)
  */
 void viewport_render(
     rct_drawpixelinfo* dpi, const rct_viewport* viewport, int32_t left, int32_t top, int32_t right, int32_t bottom,
-    std::vector<paint_session>* sessions)
+    std::vector<RecordedPaintSession>* sessions)
 {
     if (right <= viewport->x)
         return;
@@ -828,13 +831,17 @@ void viewport_render(
 #endif
 }
 
-static void viewport_fill_column(paint_session* session)
+static void viewport_fill_column(paint_session* session, RecordedPaintSession* recording)
 {
     paint_session_generate(session);
+    if (recording != nullptr)
+    {
+        paint_session_record(session, *recording);
+    }
     paint_session_arrange(session);
 }
 
-static void viewport_paint_column(paint_session* session)
+static void viewport_draw_column(paint_session* session)
 {
     if (session->ViewFlags
             & (VIEWPORT_FLAG_HIDE_VERTICAL | VIEWPORT_FLAG_HIDE_BASE | VIEWPORT_FLAG_UNDERGROUND_INSIDE
@@ -856,7 +863,11 @@ static void viewport_paint_column(paint_session* session)
     {
         viewport_paint_weather_gloom(&session->DPI);
     }
+}
 
+static void viewport_paint_column(paint_session* session)
+{
+    // Text rendering is not thread safe, so money effects are always drawn on the main thread.
     if (session->PSStringHead != nullptr)
     {
         paint_draw_money_structs(&session->DPI, session->PSStringHead);
@@ -865,6 +876,62 @@ static void viewport_paint_column(paint_session* session)
     paint_session_free(session);
 }
 
+static void viewport_save_pixels(const rct_drawpixelinfo* dpi, std::vector<uint8_t>& pixels)
+{
+    int32_t width = dpi->width >> dpi->zoom_level;
+    int32_t height = dpi->height >> dpi->zoom_level;
+    int32_t stride = width + dpi->pitch;
+    pixels.resize(width * height);
+    for (int32_t y = 0; y < height; y++)
+    {
+        std::memcpy(pixels.data() + y * width, dpi->bits + y * stride, width);
+    }
+}
+
+static void viewport_restore_pixels(const rct_drawpixelinfo* dpi, const std::vector<uint8_t>& pixels)
+{
+    int32_t width = dpi->width >> dpi->zoom_level;
+    int32_t height = dpi->height >> dpi->zoom_level;
+    int32_t stride = width + dpi->pitch;
+    for (int32_t y = 0; y < height; y++)
+    {
+        std::memcpy(dpi->bits + y * stride, pixels.data() + y * width, width);
+    }
+}
+
+/**
+ * Redraws the columns serially from the original pixels and logs how many pixels differ from the parallel result.
+ */
+static void viewport_verify_parallel_draw(
+    const rct_drawpixelinfo* dpi, const std::vector<paint_session*>& columns, const std::vector<uint8_t>& originalPixels)
+{
+    std::vector<uint8_t> parallelPixels;
+    viewport_save_pixels(dpi, parallelPixels);
+    viewport_restore_pixels(dpi, originalPixels);
+
+    for (auto&& column : columns)
+    {
+        viewport_draw_column(column);
+    }
+
+    std::vector<uint8_t> serialPixels;
+    viewport_save_pixels(dpi, serialPixels);
+    size_t numDifferent = 0;
+    for (size_t i = 0; i < serialPixels.size(); i++)
+    {
+        if (serialPixels[i] != parallelPixels[i])
+        {
+            numDifferent++;
+        }
+    }
+    if (numDifferent != 0)
+    {
+        log_warning(
+            "Parallel viewport draw differs from serial draw in %zu of %zu pixels at (%d, %d).", numDifferent,
+            serialPixels.size(), dpi->x, dpi->y);
+    }
+}
+
 /**
  *
  *  rct2: 0x00685CBF
@@ -877,7 +944,7 @@ static void viewport_paint_column(paint_session* session)
  */
 void viewport_paint(
     const rct_viewport* viewport, rct_drawpixelinfo* dpi, int16_t left, int16_t top, int16_t right, int16_t bottom,
-    std::vector<paint_session>* sessions)
+    std::vector<RecordedPaintSession>* sessions)
 {
     uint32_t viewFlags = viewport->flags;
     uint16_t width = right - left;
@@ -920,18 +987,22 @@ void viewport_paint(
 
     if (useMultithreading && _paintJobs == nullptr)
     {
-        _paintJobs = std::make_unique<JobPool>();
+        _paintJobs = std::make_unique<TaskScheduler>();
     }
     else if (useMultithreading == false && _paintJobs != nullptr)
     {
         _paintJobs.reset();
     }
 
+    // Tiles that have not changed since they were last painted in this view are replayed from the cache.
+    PaintTileCache* tileCache = gPaintTileCache.BeginPaint(viewFlags) ? &gPaintTileCache : nullptr;
+
     // Splits the area into 32 pixel columns and renders them
     size_t index = 0;
     for (x = floor2(dpi1.x, 32); x < rightBorder; x += 32, index++)
     {
         paint_session* session = paint_session_alloc(&dpi1, viewFlags);
+        session->TileCache = tileCache;
         columns.push_back(session);
 
         rct_drawpixelinfo& dpi2 = session->DPI;
@@ -952,20 +1023,62 @@ void viewport_paint(
             dpi2.pitch += rightPitch >> dpi2.zoom_level;
         }
         dpi2.width = paintRight - dpi2.x;
+    }
+
+    // Record the generated columns for the sprite sort benchmark.
+    RecordedPaintSession* recordings = nullptr;
+    if (sessions != nullptr)
+    {
+        size_t firstRecording = sessions->size();
+        sessions->resize(firstRecording + columns.size());
+        recordings = &(*sessions)[firstRecording];
+    }
+
+    // Columns cover disjoint slices of the framebuffer, so they can also be drawn in parallel if the engine allows it.
+    bool useParallelDraw = useMultithreading;
+    if (dpi->DrawingEngine != nullptr && !(dpi->DrawingEngine->GetFlags() & DEF_PARALLEL_DRAWING))
+    {
+        useParallelDraw = false;
+    }
+
+    if (useParallelDraw)
+    {
+        std::vector<uint8_t> originalPixels;
+        if (gPaintVerifyParallelDraw)
+        {
+            viewport_save_pixels(&dpi1, originalPixels);
+        }
 
+        _paintJobs->ParallelFor(columns.size(), [&columns, recordings](size_t i) {
+            viewport_fill_column(columns[i], recordings != nullptr ? &recordings[i] : nullptr);
+            viewport_draw_column(columns[i]);
+        });
+
+        if (gPaintVerifyParallelDraw)
+        {
+            viewport_verify_parallel_draw(&dpi1, columns, originalPixels);
+        }
+    }
+    else
+    {
         if (useMultithreading)
         {
-            _paintJobs->AddTask([session]() -> void { viewport_fill_column(session); });
+            _paintJobs->ParallelFor(columns.size(), [&columns, recordings](size_t i) {
+                viewport_fill_column(columns[i], recordings != nullptr ? &recordings[i] : nullptr);
+            });
         }
         else
         {
-            viewport_fill_column(session);
+            for (size_t i = 0; i < columns.size(); i++)
+            {
+                viewport_fill_column(columns[i], recordings != nullptr ? &recordings[i] : nullptr);
+            }
         }
-    }
 
-    if (useMultithreading)
-    {
-        _paintJobs->Join();
+        for (auto&& column : columns)
+        {
+            viewport_draw_column(column);
+        }
     }
 
     for (auto&& column : columns)
@@ -1666,6 +1779,9 @@ void get_map_coordinates_from_pos_window(
  */
 void viewport_invalidate(rct_viewport* viewport, int32_t left, int32_t top, int32_t right, int32_t bottom)
 {
+    if (gInTurboUpdate)
+        return;
+
     // if unknown viewport visibility, use the containing window to discover the status
     if (viewport->visibility == VC_UNKNOWN)
     {
@@ -18,6 +18,7 @@
 
 struct paint_session;
 struct paint_struct;
+struct RecordedPaintSession;
 struct rct_drawpixelinfo;
 struct Peep;
 struct TileElement;
@@ -129,6 +130,11 @@ extern uint8_t gSavedViewRotation;
 extern paint_entry* gNextFreePaintStruct;
 extern uint8_t gCurrentRotation;
 
+/**
+ * When set, viewports drawn in parallel are drawn again serially and any pixel differences are logged.
+ */
+extern bool gPaintVerifyParallelDraw;
+
 void viewport_init_all();
 std::optional<ScreenCoordsXY> centre_2d_coordinates(CoordsXYZ loc, rct_viewport* viewport);
 void viewport_create(
@@ -142,10 +148,10 @@ void viewport_update_smart_staff_follow(rct_window* window, Peep* peep);
 void viewport_update_smart_vehicle_follow(rct_window* window);
 void viewport_render(
     rct_drawpixelinfo* dpi, const rct_viewport* viewport, int32_t left, int32_t top, int32_t right, int32_t bottom,
-    std::vector<paint_session>* sessions = nullptr);
+    std::vector<RecordedPaintSession>* sessions = nullptr);
 void viewport_paint(
     const rct_viewport* viewport, rct_drawpixelinfo* dpi, int16_t left, int16_t top, int16_t right, int16_t bottom,
-    std::vector<paint_session>* sessions = nullptr);
+    std::vector<RecordedPaintSession>* sessions = nullptr);
 
 CoordsXYZ viewport_adjust_for_map_height(const ScreenCoordsXY startCoords);
 
@@ -0,0 +1,86 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "../common.h"
+#include "../core/Guard.hpp"
+#include "Paint.h"
+
+#ifdef __AVX2__
+
+#    include <immintrin.h>
+
+// Unsigned a >= b per 16-bit lane.
+static inline __m256i paint_cmpge_epu16(__m256i a, __m256i b)
+{
+    return _mm256_cmpeq_epi16(_mm256_max_epu16(a, b), a);
+}
+
+void paint_check_bounding_boxes_avx2(
+    uint8_t rotation, const paint_struct_bound_box& initialBBox, const PaintBoundsView& candidates, size_t begin, size_t end,
+    uint8_t* results)
+{
+    // Mirrors check_bounding_box<rotation>: rotations 1 and 2 flip the x comparisons, rotations 2 and 3 flip y.
+    const __m256i allSet = _mm256_set1_epi16(-1);
+    const __m256i flipX = (rotation == 1 || rotation == 2) ? allSet : _mm256_setzero_si256();
+    const __m256i flipY = (rotation == 2 || rotation == 3) ? allSet : _mm256_setzero_si256();
+    const __m256i notFlipX = _mm256_xor_si256(flipX, allSet);
+    const __m256i notFlipY = _mm256_xor_si256(flipY, allSet);
+
+    const __m256i initialX = _mm256_set1_epi16((int16_t)initialBBox.x);
+    const __m256i initialY = _mm256_set1_epi16((int16_t)initialBBox.y);
+    const __m256i initialZ = _mm256_set1_epi16((int16_t)initialBBox.z);
+    const __m256i initialXEnd = _mm256_set1_epi16((int16_t)initialBBox.x_end);
+    const __m256i initialYEnd = _mm256_set1_epi16((int16_t)initialBBox.y_end);
+    const __m256i initialZEnd = _mm256_set1_epi16((int16_t)initialBBox.z_end);
+    const __m128i one = _mm_set1_epi8(1);
+
+    size_t i = begin;
+    for (; i + 16 <= end; i += 16)
+    {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(candidates.X + i));
+        const __m256i y = _mm256_loadu_si256((const __m256i*)(candidates.Y + i));
+        const __m256i z = _mm256_loadu_si256((const __m256i*)(candidates.Z + i));
+        const __m256i xEnd = _mm256_loadu_si256((const __m256i*)(candidates.XEnd + i));
+        const __m256i yEnd = _mm256_loadu_si256((const __m256i*)(candidates.YEnd + i));
+        const __m256i zEnd = _mm256_loadu_si256((const __m256i*)(candidates.ZEnd + i));
+
+        const __m256i behindX = _mm256_xor_si256(paint_cmpge_epu16(initialXEnd, x), flipX);
+        const __m256i behindY = _mm256_xor_si256(paint_cmpge_epu16(initialYEnd, y), flipY);
+        const __m256i behindZ = paint_cmpge_epu16(initialZEnd, z);
+        const __m256i overlapX = _mm256_xor_si256(paint_cmpge_epu16(initialX, xEnd), notFlipX);
+        const __m256i overlapY = _mm256_xor_si256(paint_cmpge_epu16(initialY, yEnd), notFlipY);
+        const __m256i overlapZ = _mm256_xor_si256(paint_cmpge_epu16(initialZ, zEnd), allSet);
+
+        const __m256i behind = _mm256_and_si256(behindX, _mm256_and_si256(behindY, behindZ));
+        const __m256i overlap = _mm256_and_si256(overlapX, _mm256_and_si256(overlapY, overlapZ));
+        const __m256i result = _mm256_andnot_si256(overlap, behind);
+
+        // _mm256_packs_epi16 packs within 128-bit lanes, so narrow the two halves separately to keep the order.
+        const __m128i low = _mm256_castsi256_si128(result);
+        const __m128i high = _mm256_extracti128_si256(result, 1);
+        const __m128i bytes = _mm_and_si128(_mm_packs_epi16(low, high), one);
+        _mm_storeu_si128((__m128i*)(results + (i - begin)), bytes);
+    }
+    paint_check_bounding_boxes_scalar(rotation, initialBBox, candidates, i, end, results + (i - begin));
+}
+
+#else
+
+#    ifdef OPENRCT2_X86
+#        error You have to compile this file with AVX2 enabled, when targeting x86!
+#    endif
+
+void paint_check_bounding_boxes_avx2(
+    uint8_t rotation, const paint_struct_bound_box& initialBBox, const PaintBoundsView& candidates, size_t begin, size_t end,
+    uint8_t* results)
+{
+    openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
+}
+
+#endif // __AVX2__
@@ -16,12 +16,17 @@
 #include "../localisation/Localisation.h"
 #include "../localisation/LocalisationService.h"
 #include "../paint/Painter.h"
+#include "PaintTileCache.h"
+#include "../util/Util.h"
 #include "sprite/Paint.Sprite.h"
 #include "tile_element/Paint.TileElement.h"
 
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <functional>
+#include <unordered_map>
+#include <vector>
 
 using namespace OpenRCT2;
 
@@ -49,6 +54,12 @@ static constexpr const uint8_t BoundBoxDebugColours[] = {
 bool gShowDirtyVisuals;
 bool gPaintBoundingBoxes;
 bool gPaintBlockedTiles;
+PaintSortMethod gPaintSortMethod = PaintSortMethod::Quadrant;
+
+void (*paint_check_bounding_boxes_fn)(
+    uint8_t rotation, const paint_struct_bound_box& initialBBox, const PaintBoundsView& candidates, size_t begin, size_t end,
+    uint8_t* results)
+    = paint_check_bounding_boxes_scalar;
 
 static void paint_attached_ps(rct_drawpixelinfo* dpi, paint_struct* ps, uint32_t viewFlags);
 static void paint_ps_image_with_bounding_boxes(
@@ -56,6 +67,51 @@ static void paint_ps_image_with_bounding_boxes(
 static void paint_ps_image(rct_drawpixelinfo* dpi, paint_struct* ps, uint32_t imageId, int16_t x, int16_t y);
 static uint32_t paint_ps_colourify_image(uint32_t imageId, uint8_t spriteType, uint32_t viewFlags);
 
+paint_entry* PaintEntryArena::NextChunk()
+{
+    if (_numChunksInUse == _chunks.size())
+    {
+        _chunks.push_back(std::make_unique<paint_entry[]>(ChunkSize));
+    }
+    return _chunks[_numChunksInUse++].get();
+}
+
+void PaintEntryArena::Reset()
+{
+    // Only keep what the busier of the last two frames needed.
+    size_t numChunksToKeep = std::max(_numChunksInUse, _numChunksInUseLastFrame);
+    if (_chunks.size() > numChunksToKeep)
+    {
+        _chunks.resize(numChunksToKeep);
+    }
+    _numChunksInUseLastFrame = _numChunksInUse;
+    _numChunksInUse = 0;
+}
+
+/**
+ * Makes sure NextFreePaintStruct points at a usable entry, moving on to a new arena chunk if the current one is full.
+ * The entry is only claimed once NextFreePaintStruct is incremented.
+ */
+static void paint_session_reserve_entry(paint_session* session)
+{
+    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray)
+    {
+        session->NextFreePaintStruct = session->PaintEntries.NextChunk();
+        session->EndOfPaintStructArray = session->NextFreePaintStruct + PaintEntryArena::ChunkSize;
+    }
+}
+
+size_t paint_session_get_num_entries(const paint_session* session)
+{
+    size_t numChunks = session->PaintEntries.GetNumChunksInUse();
+    if (numChunks == 0)
+    {
+        return 0;
+    }
+    size_t numInLastChunk = PaintEntryArena::ChunkSize - (session->EndOfPaintStructArray - session->NextFreePaintStruct);
+    return (numChunks - 1) * PaintEntryArena::ChunkSize + numInLastChunk;
+}
+
 static void paint_session_add_ps_to_quadrant(paint_session* session, paint_struct* ps, int32_t positionHash)
 {
     uint32_t paintQuadrantIndex = std::clamp(positionHash / 32, 0, MAX_PAINT_QUADRANTS - 1);
@@ -67,14 +123,48 @@ static void paint_session_add_ps_to_quadrant(paint_session* session, paint_struc
     session->QuadrantFrontIndex = std::max(session->QuadrantFrontIndex, paintQuadrantIndex);
 }
 
+static int32_t paint_ps_get_attach_position_hash(const paint_struct* ps, uint8_t rotation)
+{
+    auto attach = CoordsXY{ ps->bounds.x, ps->bounds.y }.Rotate(rotation);
+    switch (rotation)
+    {
+        case 0:
+            break;
+        case 1:
+        case 3:
+            attach.x += 0x2000;
+            break;
+        case 2:
+            attach.x += 0x4000;
+            break;
+    }
+    return attach.x + attach.y;
+}
+
+static void paint_session_record_struct(paint_session* session, PaintTileCommandType type, paint_struct* ps)
+{
+    if (session->TileRecorder != nullptr)
+    {
+        session->TileRecorder->AddStruct(type, ps);
+    }
+}
+
+static void paint_session_record_attached(paint_session* session, PaintTileCommandType type, attached_paint_struct* ps)
+{
+    if (session->TileRecorder != nullptr)
+    {
+        session->TileRecorder->AddAttached(type, ps);
+    }
+}
+
 /**
  * Extracted from 0x0098196c, 0x0098197c, 0x0098198c, 0x0098199c
  */
 static paint_struct* sub_9819_c(
     paint_session* session, uint32_t image_id, const CoordsXYZ& offset, CoordsXYZ boundBoxSize, CoordsXYZ boundBoxOffset)
 {
-    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray)
-        return nullptr;
+    paint_session_reserve_entry(session);
+
     auto g1 = gfx_get_g1_element(image_id & 0x7FFFF);
     if (g1 == nullptr)
     {
@@ -101,6 +191,11 @@ static paint_struct* sub_9819_c(
     int32_t right = left + g1->width;
     int32_t top = bottom + g1->height;
 
+    if (session->TileRecorder != nullptr)
+    {
+        session->TileRecorder->SetLastBounds(left, top, right, bottom);
+    }
+
     rct_drawpixelinfo* dpi = &session->DPI;
 
     if (right <= dpi->x)
@@ -267,6 +362,40 @@ void paint_session_generate(paint_session* session)
     }
 }
 
+void paint_session_record(const paint_session* session, RecordedPaintSession& recording)
+{
+    recording.CurrentRotation = session->CurrentRotation;
+    recording.QuadrantBackIndex = session->QuadrantBackIndex;
+    recording.QuadrantFrontIndex = session->QuadrantFrontIndex;
+    recording.PaintStructs.clear();
+
+    // Number the paint structs in quadrant order first, then store the links as indices.
+    std::unordered_map<const paint_struct*, size_t> indices;
+    for (auto quadrant : session->Quadrants)
+    {
+        for (auto ps = quadrant; ps != nullptr; ps = ps->next_quadrant_ps)
+        {
+            indices[ps] = recording.PaintStructs.size();
+            recording.PaintStructs.push_back(*ps);
+        }
+    }
+
+    const auto nullIndex = recording.PaintStructs.size();
+    auto toIndex = [&indices, nullIndex](const paint_struct* ps) {
+        return (paint_struct*)(ps == nullptr ? nullIndex : indices[ps]);
+    };
+    for (auto& ps : recording.PaintStructs)
+    {
+        ps.next_quadrant_ps = toIndex(ps.next_quadrant_ps);
+        ps.attached_ps = nullptr;
+        ps.children = nullptr;
+    }
+    for (size_t i = 0; i < std::size(session->Quadrants); i++)
+    {
+        recording.Quadrants[i] = toIndex(session->Quadrants[i]);
+    }
+}
+
 template<uint8_t>
 static bool check_bounding_box(const paint_struct_bound_box& initialBBox, const paint_struct_bound_box& currentBBox)
 {
@@ -313,6 +442,56 @@ template<> bool check_bounding_box<3>(const paint_struct_bound_box& initialBBox,
     return false;
 }
 
+template<uint8_t _TRotation>
+static void paint_check_bounding_boxes_rotation(
+    const paint_struct_bound_box& initialBBox, const PaintBoundsView& candidates, size_t begin, size_t end, uint8_t* results)
+{
+    for (size_t i = begin; i < end; i++)
+    {
+        results[i - begin] = check_bounding_box<_TRotation>(initialBBox, candidates.Get(i)) ? 1 : 0;
+    }
+}
+
+void paint_check_bounding_boxes_scalar(
+    uint8_t rotation, const paint_struct_bound_box& initialBBox, const PaintBoundsView& candidates, size_t begin, size_t end,
+    uint8_t* results)
+{
+    switch (rotation)
+    {
+        case 0:
+            paint_check_bounding_boxes_rotation<0>(initialBBox, candidates, begin, end, results);
+            break;
+        case 1:
+            paint_check_bounding_boxes_rotation<1>(initialBBox, candidates, begin, end, results);
+            break;
+        case 2:
+            paint_check_bounding_boxes_rotation<2>(initialBBox, candidates, begin, end, results);
+            break;
+        case 3:
+            paint_check_bounding_boxes_rotation<3>(initialBBox, candidates, begin, end, results);
+            break;
+    }
+}
+
+void paint_sort_init()
+{
+    if (avx2_available())
+    {
+        log_verbose("registering AVX2 bounding box check function");
+        paint_check_bounding_boxes_fn = paint_check_bounding_boxes_avx2;
+    }
+    else if (sse41_available())
+    {
+        log_verbose("registering SSE4.1 bounding box check function");
+        paint_check_bounding_boxes_fn = paint_check_bounding_boxes_sse4_1;
+    }
+    else
+    {
+        log_verbose("registering scalar bounding box check function");
+        paint_check_bounding_boxes_fn = paint_check_bounding_boxes_scalar;
+    }
+}
+
 template<uint8_t _TRotation>
 static paint_struct* paint_arrange_structs_helper_rotation(paint_struct* ps_next, uint16_t quadrantIndex, uint8_t flag)
 {
@@ -419,7 +598,7 @@ paint_struct* paint_arrange_structs_helper(paint_struct* ps_next, uint16_t quadr
  *
  *  rct2: 0x00688217
  */
-void paint_session_arrange(paint_session* session)
+static void paint_session_arrange_quadrant(paint_session* session)
 {
     paint_struct* psHead = &session->PaintHead;
 
@@ -455,6 +634,501 @@ void paint_session_arrange(paint_session* session)
     }
 }
 
+/**
+ * Hot data of the quadrant sort, split out of paint_struct so the sort loop only streams through the fields it
+ * compares. Entry 0 stands in for the session's paint head.
+ */
+struct PaintSortArrays
+{
+    static constexpr uint32_t NullIndex = UINT32_MAX;
+
+    std::vector<uint16_t> X;
+    std::vector<uint16_t> Y;
+    std::vector<uint16_t> Z;
+    std::vector<uint16_t> XEnd;
+    std::vector<uint16_t> YEnd;
+    std::vector<uint16_t> ZEnd;
+    std::vector<uint16_t> QuadrantIndex;
+    std::vector<uint8_t> QuadrantFlags;
+    std::vector<uint32_t> Next;
+    std::vector<paint_struct*> PaintStructs;
+
+    // First index of each quadrant from QuadrantBackIndex onwards, followed by the total count.
+    uint32_t QuadrantBackIndex;
+    std::vector<uint32_t> QuadrantFirst;
+    std::vector<uint8_t> Results;
+
+    void Clear()
+    {
+        X.clear();
+        Y.clear();
+        Z.clear();
+        XEnd.clear();
+        YEnd.clear();
+        ZEnd.clear();
+        QuadrantIndex.clear();
+        QuadrantFlags.clear();
+        Next.clear();
+        PaintStructs.clear();
+        QuadrantFirst.clear();
+    }
+
+    void Add(paint_struct* ps)
+    {
+        X.push_back(ps->bounds.x);
+        Y.push_back(ps->bounds.y);
+        Z.push_back(ps->bounds.z);
+        XEnd.push_back(ps->bounds.x_end);
+        YEnd.push_back(ps->bounds.y_end);
+        ZEnd.push_back(ps->bounds.z_end);
+        QuadrantIndex.push_back(ps->quadrant_index);
+        QuadrantFlags.push_back(ps->quadrant_flags);
+        Next.push_back(NullIndex);
+        PaintStructs.push_back(ps);
+    }
+
+    PaintBoundsView GetBoundsView() const
+    {
+        return { X.data(), Y.data(), Z.data(), XEnd.data(), YEnd.data(), ZEnd.data() };
+    }
+};
+
+static thread_local PaintSortArrays _paintSortArrays;
+
+// Index based copy of paint_arrange_structs_helper_rotation, it must make exactly the same decisions.
+template<uint8_t _TRotation>
+static uint32_t paint_arrange_structs_helper_soa(PaintSortArrays& arrays, uint32_t ps_next, uint16_t quadrantIndex, uint8_t flag)
+{
+    constexpr uint32_t NullIndex = PaintSortArrays::NullIndex;
+    auto& next = arrays.Next;
+    auto& quadrantFlags = arrays.QuadrantFlags;
+    const auto& quadrantIndices = arrays.QuadrantIndex;
+    const auto bounds = arrays.GetBoundsView();
+
+    // Every paint struct of this and the next quadrant is tested against each initial box in one batch.
+    const uint32_t lastQuadrant = (uint32_t)arrays.QuadrantFirst.size() - 1;
+    const uint32_t batchBegin = arrays.QuadrantFirst[std::min(quadrantIndex - arrays.QuadrantBackIndex, lastQuadrant)];
+    const uint32_t batchEnd = arrays.QuadrantFirst[std::min(quadrantIndex - arrays.QuadrantBackIndex + 2, lastQuadrant)];
+    arrays.Results.resize(batchEnd - batchBegin);
+    uint8_t* results = arrays.Results.data();
+
+    uint32_t ps;
+    uint32_t ps_temp;
+    do
+    {
+        ps = ps_next;
+        ps_next = next[ps_next];
+        if (ps_next == NullIndex)
+            return ps;
+    } while (quadrantIndex > quadrantIndices[ps_next]);
+
+    // Cache the last visited node so we don't have to walk the whole list again
+    uint32_t ps_cache = ps;
+
+    ps_temp = ps;
+    do
+    {
+        ps = next[ps];
+        if (ps == NullIndex)
+            break;
+
+        if (quadrantIndices[ps] > quadrantIndex + 1)
+        {
+            quadrantFlags[ps] = PAINT_QUADRANT_FLAG_BIGGER;
+        }
+        else if (quadrantIndices[ps] == quadrantIndex + 1)
+        {
+            quadrantFlags[ps] = PAINT_QUADRANT_FLAG_NEXT | PAINT_QUADRANT_FLAG_IDENTICAL;
+        }
+        else if (quadrantIndices[ps] == quadrantIndex)
+        {
+            quadrantFlags[ps] = flag | PAINT_QUADRANT_FLAG_IDENTICAL;
+        }
+    } while (quadrantIndices[ps] <= quadrantIndex + 1);
+    ps = ps_temp;
+
+    while (true)
+    {
+        while (true)
+        {
+            ps_next = next[ps];
+            if (ps_next == NullIndex)
+                return ps_cache;
+            if (quadrantFlags[ps_next] & PAINT_QUADRANT_FLAG_BIGGER)
+                return ps_cache;
+            if (quadrantFlags[ps_next] & PAINT_QUADRANT_FLAG_IDENTICAL)
+                break;
+            ps = ps_next;
+        }
+
+        quadrantFlags[ps_next] &= ~PAINT_QUADRANT_FLAG_IDENTICAL;
+        ps_temp = ps;
+
+        const paint_struct_bound_box initialBBox = bounds.Get(ps_next);
+        paint_check_bounding_boxes_fn(_TRotation, initialBBox, bounds, batchBegin, batchEnd, results);
+
+        while (true)
+        {
+            ps = ps_next;
+            ps_next = next[ps_next];
+            if (ps_next == NullIndex)
+                break;
+            if (quadrantFlags[ps_next] & PAINT_QUADRANT_FLAG_BIGGER)
+                break;
+            if (!(quadrantFlags[ps_next] & PAINT_QUADRANT_FLAG_NEXT))
+                continue;
+
+            bool compareResult;
+            if (ps_next >= batchBegin && ps_next < batchEnd)
+            {
+                compareResult = results[ps_next - batchBegin] != 0;
+            }
+            else
+            {
+                compareResult = check_bounding_box<_TRotation>(initialBBox, bounds.Get(ps_next));
+            }
+
+            if (compareResult)
+            {
+                next[ps] = next[ps_next];
+                uint32_t ps_temp2 = next[ps_temp];
+                next[ps_temp] = ps_next;
+                next[ps_next] = ps_temp2;
+                ps_next = ps;
+            }
+        }
+
+        ps = ps_temp;
+    }
+}
+
+template<uint8_t _TRotation> static void paint_session_arrange_soa_rotation(paint_session* session, PaintSortArrays& arrays)
+{
+    uint32_t ps_cache = paint_arrange_structs_helper_soa<_TRotation>(
+        arrays, 0, session->QuadrantBackIndex & 0xFFFF, PAINT_QUADRANT_FLAG_NEXT);
+
+    uint32_t quadrantIndex = session->QuadrantBackIndex;
+    while (++quadrantIndex < session->QuadrantFrontIndex)
+    {
+        ps_cache = paint_arrange_structs_helper_soa<_TRotation>(arrays, ps_cache, quadrantIndex & 0xFFFF, 0);
+    }
+}
+
+static void paint_session_arrange_quadrant_soa(paint_session* session)
+{
+    paint_struct* psHead = &session->PaintHead;
+    psHead->next_quadrant_ps = nullptr;
+    if (session->QuadrantBackIndex == UINT32_MAX)
+    {
+        return;
+    }
+
+    // Gather the quadrant lists back to front, this is the order paint_session_arrange_quadrant links them in.
+    auto& arrays = _paintSortArrays;
+    arrays.Clear();
+    arrays.Add(psHead);
+    arrays.QuadrantBackIndex = session->QuadrantBackIndex;
+    uint32_t last = 0;
+    for (uint32_t quadrantIndex = session->QuadrantBackIndex; quadrantIndex <= session->QuadrantFrontIndex; quadrantIndex++)
+    {
+        arrays.QuadrantFirst.push_back((uint32_t)arrays.PaintStructs.size());
+        for (paint_struct* ps = session->Quadrants[quadrantIndex]; ps != nullptr; ps = ps->next_quadrant_ps)
+        {
+            uint32_t index = (uint32_t)arrays.PaintStructs.size();
+            arrays.Add(ps);
+            arrays.Next[last] = index;
+            last = index;
+        }
+    }
+    arrays.QuadrantFirst.push_back((uint32_t)arrays.PaintStructs.size());
+
+    switch (session->CurrentRotation)
+    {
+        case 0:
+            paint_session_arrange_soa_rotation<0>(session, arrays);
+            break;
+        case 1:
+            paint_session_arrange_soa_rotation<1>(session, arrays);
+            break;
+        case 2:
+            paint_session_arrange_soa_rotation<2>(session, arrays);
+            break;
+        case 3:
+            paint_session_arrange_soa_rotation<3>(session, arrays);
+            break;
+    }
+
+    // Write the sorted order back to the paint structs.
+    paint_struct* ps = psHead;
+    for (uint32_t index = arrays.Next[0]; index != PaintSortArrays::NullIndex; index = arrays.Next[index])
+    {
+        paint_struct* ps_next = arrays.PaintStructs[index];
+        ps_next->quadrant_flags = arrays.QuadrantFlags[index];
+        ps->next_quadrant_ps = ps_next;
+        ps = ps_next;
+    }
+    ps->next_quadrant_ps = nullptr;
+}
+
+struct PaintSortNode
+{
+    paint_struct* PaintStruct;
+    int32_t Left;
+    int32_t Top;
+    int32_t Right;
+    int32_t Bottom;
+};
+
+// Scratch space for the topological sort, kept per thread so sessions can be arranged concurrently.
+struct PaintSortScratch
+{
+    std::vector<PaintSortNode> Nodes;
+    std::vector<uint32_t> NodesByLeft;
+    std::vector<uint32_t> Active;
+    std::vector<std::pair<uint32_t, uint32_t>> Edges;
+    std::vector<uint32_t> EdgeStart;
+    std::vector<uint32_t> Successors;
+    std::vector<uint32_t> InDegree;
+    std::vector<uint8_t> Emitted;
+    std::vector<uint32_t> Ready;
+};
+
+static thread_local PaintSortScratch _paintSortScratch;
+
+// Screen space rectangle covered by the projection of a bounding box.
+static void paint_sort_project_bounds(PaintSortNode& node, uint8_t rotation)
+{
+    const paint_struct_bound_box& bounds = node.PaintStruct->bounds;
+    const CoordsXY corners[] = {
+        { bounds.x, bounds.y },
+        { bounds.x_end, bounds.y },
+        { bounds.x, bounds.y_end },
+        { bounds.x_end, bounds.y_end },
+    };
+    node.Left = INT32_MAX;
+    node.Right = INT32_MIN;
+    int32_t groundTop = INT32_MAX;
+    int32_t groundBottom = INT32_MIN;
+    for (const auto& corner : corners)
+    {
+        auto screenCoords = translate_3d_to_2d_with_z(rotation, CoordsXYZ{ corner, 0 });
+        node.Left = std::min(node.Left, screenCoords.x);
+        node.Right = std::max(node.Right, screenCoords.x);
+        groundTop = std::min(groundTop, screenCoords.y);
+        groundBottom = std::max(groundBottom, screenCoords.y);
+    }
+    node.Top = groundTop - bounds.z_end;
+    node.Bottom = groundBottom - bounds.z;
+}
+
+/**
+ * Finds every pair of paint structs in the same or neighbouring quadrants (the pairs the quadrant sort compares)
+ * whose projected bounding boxes overlap, by sweeping over the screen from left to right. An edge points from the
+ * paint struct that has to be drawn first to the one drawn over it.
+ */
+template<uint8_t _TRotation> static void paint_sort_build_graph(PaintSortScratch& scratch)
+{
+    auto& nodes = scratch.Nodes;
+    auto& nodesByLeft = scratch.NodesByLeft;
+    auto& active = scratch.Active;
+    auto& edges = scratch.Edges;
+
+    nodesByLeft.resize(nodes.size());
+    for (uint32_t i = 0; i < nodes.size(); i++)
+    {
+        nodesByLeft[i] = i;
+    }
+    std::sort(nodesByLeft.begin(), nodesByLeft.end(), [&nodes](uint32_t a, uint32_t b) {
+        return nodes[a].Left < nodes[b].Left || (nodes[a].Left == nodes[b].Left && a < b);
+    });
+
+    active.clear();
+    edges.clear();
+    for (uint32_t current : nodesByLeft)
+    {
+        const PaintSortNode& node = nodes[current];
+        size_t numActive = 0;
+        for (uint32_t other : active)
+        {
+            const PaintSortNode& otherNode = nodes[other];
+            if (otherNode.Right < node.Left)
+            {
+                continue;
+            }
+            active[numActive++] = other;
+
+            if (otherNode.Bottom < node.Top || node.Bottom < otherNode.Top)
+            {
+                continue;
+            }
+            int32_t quadrantDistance = node.PaintStruct->quadrant_index - otherNode.PaintStruct->quadrant_index;
+            if (quadrantDistance < -1 || quadrantDistance > 1)
+            {
+                continue;
+            }
+
+            // Same predicate the quadrant sort uses to decide that `current` must be drawn before `initial`.
+            const uint32_t initial = std::min(current, other);
+            const uint32_t later = std::max(current, other);
+            const auto& initialBBox = nodes[initial].PaintStruct->bounds;
+            const auto& laterBBox = nodes[later].PaintStruct->bounds;
+            const bool laterIsBehind = check_bounding_box<_TRotation>(initialBBox, laterBBox);
+            const bool initialIsBehind = check_bounding_box<_TRotation>(laterBBox, initialBBox);
+            if (laterIsBehind && !initialIsBehind)
+            {
+                edges.emplace_back(later, initial);
+            }
+            else if (initialIsBehind && !laterIsBehind)
+            {
+                edges.emplace_back(initial, later);
+            }
+        }
+        active.resize(numActive);
+        active.push_back(current);
+    }
+}
+
+static void paint_session_arrange_topological(paint_session* session)
+{
+    paint_struct* psHead = &session->PaintHead;
+    psHead->next_quadrant_ps = nullptr;
+    if (session->QuadrantBackIndex == UINT32_MAX)
+    {
+        return;
+    }
+
+    auto& scratch = _paintSortScratch;
+    auto& nodes = scratch.Nodes;
+    nodes.clear();
+    for (uint32_t quadrantIndex = session->QuadrantBackIndex; quadrantIndex <= session->QuadrantFrontIndex; quadrantIndex++)
+    {
+        for (paint_struct* ps = session->Quadrants[quadrantIndex]; ps != nullptr; ps = ps->next_quadrant_ps)
+        {
+            PaintSortNode node;
+            node.PaintStruct = ps;
+            paint_sort_project_bounds(node, session->CurrentRotation);
+            nodes.push_back(node);
+        }
+    }
+
+    switch (session->CurrentRotation)
+    {
+        case 0:
+            paint_sort_build_graph<0>(scratch);
+            break;
+        case 1:
+            paint_sort_build_graph<1>(scratch);
+            break;
+        case 2:
+            paint_sort_build_graph<2>(scratch);
+            break;
+        case 3:
+            paint_sort_build_graph<3>(scratch);
+            break;
+    }
+
+    // Compact the edge list into per node successor lists.
+    const uint32_t numNodes = (uint32_t)nodes.size();
+    auto& edgeStart = scratch.EdgeStart;
+    auto& successors = scratch.Successors;
+    auto& inDegree = scratch.InDegree;
+    edgeStart.assign(numNodes + 1, 0);
+    inDegree.assign(numNodes, 0);
+    for (const auto& edge : scratch.Edges)
+    {
+        edgeStart[edge.first + 1]++;
+        inDegree[edge.second]++;
+    }
+    for (uint32_t i = 0; i < numNodes; i++)
+    {
+        edgeStart[i + 1] += edgeStart[i];
+    }
+    successors.resize(scratch.Edges.size());
+    for (const auto& edge : scratch.Edges)
+    {
+        successors[edgeStart[edge.first]++] = edge.second;
+    }
+    for (uint32_t i = numNodes; i > 0; i--)
+    {
+        edgeStart[i] = edgeStart[i - 1];
+    }
+    edgeStart[0] = 0;
+
+    // Kahn's algorithm, always emitting the earliest ready node so unconstrained paint structs keep the quadrant
+    // order. Cycles are broken by force emitting the earliest remaining node.
+    auto& emitted = scratch.Emitted;
+    auto& ready = scratch.Ready;
+    emitted.assign(numNodes, 0);
+    ready.clear();
+    for (uint32_t i = 0; i < numNodes; i++)
+    {
+        if (inDegree[i] == 0)
+        {
+            ready.push_back(i);
+        }
+    }
+    std::make_heap(ready.begin(), ready.end(), std::greater<uint32_t>());
+
+    paint_struct* ps = psHead;
+    uint32_t firstRemaining = 0;
+    for (uint32_t numEmitted = 0; numEmitted < numNodes; numEmitted++)
+    {
+        uint32_t next;
+        if (!ready.empty())
+        {
+            std::pop_heap(ready.begin(), ready.end(), std::greater<uint32_t>());
+            next = ready.back();
+            ready.pop_back();
+        }
+        else
+        {
+            while (emitted[firstRemaining])
+            {
+                firstRemaining++;
+            }
+            next = firstRemaining;
+        }
+
+        emitted[next] = 1;
+        ps->next_quadrant_ps = nodes[next].PaintStruct;
+        ps = ps->next_quadrant_ps;
+
+        for (uint32_t i = edgeStart[next]; i < edgeStart[next + 1]; i++)
+        {
+            uint32_t successor = successors[i];
+            if (--inDegree[successor] == 0 && !emitted[successor])
+            {
+                ready.push_back(successor);
+                std::push_heap(ready.begin(), ready.end(), std::greater<uint32_t>());
+            }
+        }
+    }
+    ps->next_quadrant_ps = nullptr;
+}
+
+void paint_session_arrange(paint_session* session, PaintSortMethod method)
+{
+    switch (method)
+    {
+        case PaintSortMethod::Quadrant:
+            paint_session_arrange_quadrant(session);
+            break;
+        case PaintSortMethod::Topological:
+            paint_session_arrange_topological(session);
+            break;
+        case PaintSortMethod::QuadrantSoA:
+            paint_session_arrange_quadrant_soa(session);
+            break;
+        case PaintSortMethod::Count:
+            break;
+    }
+}
+
+void paint_session_arrange(paint_session* session)
+{
+    paint_session_arrange(session, gPaintSortMethod);
+}
+
 static void paint_draw_struct(paint_session* session, paint_struct* ps)
 {
     rct_drawpixelinfo* dpi = &session->DPI;
@@ -730,14 +1404,12 @@ paint_struct* sub_98196C(
     session->LastRootPS = nullptr;
     session->UnkF1AD2C = nullptr;
 
-    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray)
-    {
-        return nullptr;
-    }
+    paint_session_reserve_entry(session);
 
     auto g1Element = gfx_get_g1_element(image_id & 0x7FFFF);
     if (g1Element == nullptr)
     {
+        paint_session_record_struct(session, PaintTileCommandType::Root, nullptr);
         return nullptr;
     }
 
@@ -807,16 +1479,18 @@ paint_struct* sub_98196C(
     int16_t right = left + g1Element->width;
     int16_t top = bottom + g1Element->height;
 
+    if (session->TileRecorder != nullptr)
+    {
+        session->TileRecorder->SetLastBounds(left, top, right, bottom);
+    }
+
     rct_drawpixelinfo* dpi = &session->DPI;
 
-    if (right <= dpi->x)
-        return nullptr;
-    if (top <= dpi->y)
-        return nullptr;
-    if (left >= (dpi->x + dpi->width))
-        return nullptr;
-    if (bottom >= (dpi->y + dpi->height))
+    if (right <= dpi->x || top <= dpi->y || left >= (dpi->x + dpi->width) || bottom >= (dpi->y + dpi->height))
+    {
+        paint_session_record_struct(session, PaintTileCommandType::Root, nullptr);
         return nullptr;
+    }
 
     ps->flags = 0;
     ps->bounds.x = coord_3d.x;
@@ -848,6 +1522,7 @@ paint_struct* sub_98196C(
             break;
     }
     paint_session_add_ps_to_quadrant(session, ps, positionHash);
+    paint_session_record_struct(session, PaintTileCommandType::Root, ps);
 
     session->NextFreePaintStruct++;
 
@@ -882,6 +1557,7 @@ paint_struct* sub_98197C(
     CoordsXYZ boundBoxSize = { bound_box_length_x, bound_box_length_y, bound_box_length_z };
     CoordsXYZ boundBoxOffset = { bound_box_offset_x, bound_box_offset_y, bound_box_offset_z };
     paint_struct* ps = sub_9819_c(session, image_id, offset, boundBoxSize, boundBoxOffset);
+    paint_session_record_struct(session, PaintTileCommandType::Root, ps);
 
     if (ps == nullptr)
     {
@@ -890,21 +1566,7 @@ paint_struct* sub_98197C(
 
     session->LastRootPS = ps;
 
-    auto attach = CoordsXY{ ps->bounds.x, ps->bounds.y }.Rotate(session->CurrentRotation);
-    switch (session->CurrentRotation)
-    {
-        case 0:
-            break;
-        case 1:
-        case 3:
-            attach.x += 0x2000;
-            break;
-        case 2:
-            attach.x += 0x4000;
-            break;
-    }
-
-    int32_t positionHash = attach.x + attach.y;
+    int32_t positionHash = paint_ps_get_attach_position_hash(ps, session->CurrentRotation);
     paint_session_add_ps_to_quadrant(session, ps, positionHash);
 
     session->NextFreePaintStruct++;
@@ -942,6 +1604,7 @@ paint_struct* sub_98198C(
     CoordsXYZ boundBoxSize = { bound_box_length_x, bound_box_length_y, bound_box_length_z };
     CoordsXYZ boundBoxOffset = { bound_box_offset_x, bound_box_offset_y, bound_box_offset_z };
     paint_struct* ps = sub_9819_c(session, image_id, offset, boundBoxSize, boundBoxOffset);
+    paint_session_record_struct(session, PaintTileCommandType::RootUnlinked, ps);
 
     if (ps == nullptr)
     {
@@ -977,6 +1640,11 @@ paint_struct* sub_98199C(
     assert((uint16_t)bound_box_length_x == (int16_t)bound_box_length_x);
     assert((uint16_t)bound_box_length_y == (int16_t)bound_box_length_y);
 
+    if (session->TileRecorder != nullptr)
+    {
+        session->TileRecorder->CheckPriorState();
+    }
+
     if (session->LastRootPS == nullptr)
     {
         return sub_98197C(
@@ -988,6 +1656,7 @@ paint_struct* sub_98199C(
     CoordsXYZ boundBox = { bound_box_length_x, bound_box_length_y, bound_box_length_z };
     CoordsXYZ boundBoxOffset = { bound_box_offset_x, bound_box_offset_y, bound_box_offset_z };
     paint_struct* ps = sub_9819_c(session, image_id, offset, boundBox, boundBoxOffset);
+    paint_session_record_struct(session, PaintTileCommandType::Child, ps);
 
     if (ps == nullptr)
     {
@@ -1017,10 +1686,7 @@ bool paint_attach_to_previous_attach(paint_session* session, uint32_t image_id,
         return paint_attach_to_previous_ps(session, image_id, x, y);
     }
 
-    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray)
-    {
-        return false;
-    }
+    paint_session_reserve_entry(session);
     attached_paint_struct* ps = &session->NextFreePaintStruct->attached;
     ps->image_id = image_id;
     ps->x = x;
@@ -1033,6 +1699,7 @@ bool paint_attach_to_previous_attach(paint_session* session, uint32_t image_id,
     ebx->next = ps;
 
     session->UnkF1AD2C = ps;
+    paint_session_record_attached(session, PaintTileCommandType::AttachToAttach, ps);
 
     session->NextFreePaintStruct++;
 
@@ -1049,10 +1716,7 @@ bool paint_attach_to_previous_attach(paint_session* session, uint32_t image_id,
  */
 bool paint_attach_to_previous_ps(paint_session* session, uint32_t image_id, uint16_t x, uint16_t y)
 {
-    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray)
-    {
-        return false;
-    }
+    paint_session_reserve_entry(session);
     attached_paint_struct* ps = &session->NextFreePaintStruct->attached;
 
     ps->image_id = image_id;
@@ -1060,6 +1724,11 @@ bool paint_attach_to_previous_ps(paint_session* session, uint32_t image_id, uint
     ps->y = y;
     ps->flags = 0;
 
+    if (session->TileRecorder != nullptr)
+    {
+        session->TileRecorder->CheckPriorState();
+    }
+
     paint_struct* masterPs = session->LastRootPS;
     if (masterPs == nullptr)
     {
@@ -1074,10 +1743,146 @@ bool paint_attach_to_previous_ps(paint_session* session, uint32_t image_id, uint
     ps->next = oldFirstAttached;
 
     session->UnkF1AD2C = ps;
+    paint_session_record_attached(session, PaintTileCommandType::AttachToPS, ps);
 
     return true;
 }
 
+void paint_session_set_tile_volatile(paint_session* session)
+{
+    if (session->TileRecorder != nullptr)
+    {
+        session->TileRecorder->SetVolatile();
+    }
+}
+
+static paint_struct* paint_session_replay_struct(
+    paint_session* session, const PaintTileRecording& recording, const PaintTileCommand& command)
+{
+    if (!command.HasStruct)
+    {
+        return nullptr;
+    }
+
+    const rct_drawpixelinfo* dpi = &session->DPI;
+    if (command.Right <= dpi->x || command.Top <= dpi->y || command.Left >= dpi->x + dpi->width
+        || command.Bottom >= dpi->y + dpi->height)
+    {
+        return nullptr;
+    }
+
+    paint_session_reserve_entry(session);
+    paint_struct* ps = &session->NextFreePaintStruct->basic;
+    *ps = recording.Structs[command.Index];
+    ps->attached_ps = nullptr;
+    ps->children = nullptr;
+    ps->next_quadrant_ps = nullptr;
+    session->NextFreePaintStruct++;
+    return ps;
+}
+
+static void paint_session_replay_attached(
+    paint_session* session, const PaintTileRecording& recording, const PaintTileCommand& command)
+{
+    attached_paint_struct* previous = session->UnkF1AD2C;
+    if (command.Type == PaintTileCommandType::AttachToPS || previous == nullptr)
+    {
+        paint_struct* masterPs = session->LastRootPS;
+        if (masterPs == nullptr)
+        {
+            return;
+        }
+
+        paint_session_reserve_entry(session);
+        attached_paint_struct* ps = &session->NextFreePaintStruct->attached;
+        *ps = recording.Attached[command.Index];
+        ps->next = masterPs->attached_ps;
+        masterPs->attached_ps = ps;
+        session->UnkF1AD2C = ps;
+        session->NextFreePaintStruct++;
+    }
+    else
+    {
+        paint_session_reserve_entry(session);
+        attached_paint_struct* ps = &session->NextFreePaintStruct->attached;
+        *ps = recording.Attached[command.Index];
+        ps->next = nullptr;
+        previous->next = ps;
+        session->UnkF1AD2C = ps;
+        session->NextFreePaintStruct++;
+    }
+}
+
+/**
+ * Adds the structs of a recorded tile to the session. Runs the same culling and linking as the calls that were
+ * recorded, so the result is identical to painting the tile again.
+ */
+void paint_session_replay_tile(paint_session* session, const PaintTileRecording& recording)
+{
+    const rct_drawpixelinfo* dpi = &session->DPI;
+    if (!recording.Painted || recording.ScreenBottom <= dpi->y || recording.ScreenTop - dpi->height >= dpi->y)
+    {
+        return;
+    }
+
+    for (const auto& command : recording.Commands)
+    {
+        switch (command.Type)
+        {
+            case PaintTileCommandType::Root:
+            case PaintTileCommandType::RootUnlinked:
+            {
+                session->LastRootPS = nullptr;
+                session->UnkF1AD2C = nullptr;
+                paint_struct* ps = paint_session_replay_struct(session, recording, command);
+                if (ps != nullptr)
+                {
+                    session->LastRootPS = ps;
+                    if (command.Type == PaintTileCommandType::Root)
+                    {
+                        paint_session_add_ps_to_quadrant(session, ps, ps->quadrant_index * 32);
+                    }
+                }
+                break;
+            }
+            case PaintTileCommandType::Child:
+            {
+                if (session->LastRootPS == nullptr)
+                {
+                    // The parent was culled from this view, sub_98199C falls back to sub_98197C.
+                    session->UnkF1AD2C = nullptr;
+                    paint_struct* ps = paint_session_replay_struct(session, recording, command);
+                    if (ps != nullptr)
+                    {
+                        session->LastRootPS = ps;
+                        int32_t positionHash = paint_ps_get_attach_position_hash(ps, session->CurrentRotation);
+                        paint_session_add_ps_to_quadrant(session, ps, positionHash);
+                    }
+                }
+                else
+                {
+                    paint_struct* ps = paint_session_replay_struct(session, recording, command);
+                    if (ps != nullptr)
+                    {
+                        session->LastRootPS->children = ps;
+                        session->LastRootPS = ps;
+                    }
+                }
+                break;
+            }
+            case PaintTileCommandType::AttachToPS:
+            case PaintTileCommandType::AttachToAttach:
+                paint_session_replay_attached(session, recording, command);
+                break;
+        }
+    }
+
+    if (recording.SurfaceElement != nullptr)
+    {
+        session->SurfaceElement = recording.SurfaceElement;
+    }
+}
+
 /**
  * rct2: 0x00685EBC, 0x00686046, 0x00685FC8, 0x00685F4A, 0x00685ECC
  * @param amount (eax)
@@ -1092,10 +1897,7 @@ void paint_floating_money_effect(
     paint_session* session, money32 amount, rct_string_id string_id, int16_t y, int16_t z, int8_t y_offsets[], int16_t offset_x,
     uint32_t rotation)
 {
-    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray)
-    {
-        return;
-    }
+    paint_session_reserve_entry(session);
 
     paint_string_struct* ps = &session->NextFreePaintStruct->string;
     ps->string_id = string_id;
@@ -14,7 +14,14 @@
 #include "../interface/Colour.h"
 #include "../world/Location.hpp"
 
+#include <array>
+#include <memory>
+#include <vector>
+
 struct TileElement;
+struct PaintTileRecording;
+class PaintTileRecorder;
+class PaintTileCache;
 
 #pragma pack(push, 1)
 /* size 0x12 */
@@ -55,6 +62,24 @@ struct paint_struct_bound_box
     uint16_t z_end;
 };
 
+/**
+ * Bounding boxes stored as one array per field, so one box can be tested against a batch of others at once.
+ */
+struct PaintBoundsView
+{
+    const uint16_t* X;
+    const uint16_t* Y;
+    const uint16_t* Z;
+    const uint16_t* XEnd;
+    const uint16_t* YEnd;
+    const uint16_t* ZEnd;
+
+    paint_struct_bound_box Get(size_t index) const
+    {
+        return { X[index], Y[index], Z[index], XEnd[index], YEnd[index], ZEnd[index] };
+    }
+};
+
 /* size 0x34 */
 struct paint_struct
 {
@@ -137,10 +162,46 @@ struct tunnel_entry
 #define MAX_PAINT_QUADRANTS 512
 #define TUNNEL_MAX_COUNT 65
 
+/**
+ * Bump allocator for the paint entries of a session. Entries are handed out from fixed size chunks which are
+ * allocated on demand, so a session never runs out of entries, and kept when the session is reused for the next
+ * frame. Chunks that were not needed for the last two frames are released again.
+ */
+class PaintEntryArena
+{
+public:
+    static constexpr size_t ChunkSize = 256;
+
+    /**
+     * Returns the first entry of a fresh chunk, allocating a new chunk if all existing ones are in use.
+     */
+    paint_entry* NextChunk();
+
+    /**
+     * Marks all chunks as unused, to be called before the session is used for a new frame.
+     */
+    void Reset();
+
+    size_t GetNumChunksInUse() const
+    {
+        return _numChunksInUse;
+    }
+
+    size_t GetNumChunksAllocated() const
+    {
+        return _chunks.size();
+    }
+
+private:
+    std::vector<std::unique_ptr<paint_entry[]>> _chunks;
+    size_t _numChunksInUse = 0;
+    size_t _numChunksInUseLastFrame = 0;
+};
+
 struct paint_session
 {
     rct_drawpixelinfo DPI;
-    paint_entry PaintStructs[4000];
+    PaintEntryArena PaintEntries;
     paint_struct* Quadrants[MAX_PAINT_QUADRANTS];
     paint_struct PaintHead;
     uint32_t ViewFlags;
@@ -172,6 +233,22 @@ struct paint_session
     uint8_t Unk141E9DB;
     uint16_t WaterHeight;
     uint32_t TrackColours[4];
+    PaintTileCache* TileCache;
+    PaintTileRecorder* TileRecorder;
+};
+
+/**
+ * Copy of the quadrant lists of a generated paint session that does not depend on the session's arena. Pointers are
+ * stored as indices into PaintStructs, with PaintStructs.size() standing for nullptr. Used to feed the sprite sort
+ * benchmark.
+ */
+struct RecordedPaintSession
+{
+    uint8_t CurrentRotation;
+    uint32_t QuadrantBackIndex;
+    uint32_t QuadrantFrontIndex;
+    std::vector<paint_struct> PaintStructs;
+    std::array<paint_struct*, MAX_PAINT_QUADRANTS> Quadrants;
 };
 
 extern paint_session gPaintSession;
@@ -188,6 +265,19 @@ extern bool gPaintBoundingBoxes;
 extern bool gPaintBlockedTiles;
 extern bool gPaintWidePathsAsGhost;
 
+enum class PaintSortMethod : uint8_t
+{
+    // Original insertion sort over neighbouring quadrants of the linked list.
+    Quadrant,
+    // Topological sort over the graph of paint structs whose bounding boxes overlap on screen.
+    Topological,
+    // Same result as Quadrant, but sorts a copy of the bounds and links kept in separate arrays.
+    QuadrantSoA,
+
+    Count
+};
+extern PaintSortMethod gPaintSortMethod;
+
 paint_struct* sub_98196C(
     paint_session* session, uint32_t image_id, int8_t x_offset, int8_t y_offset, int16_t bound_box_length_x,
     int16_t bound_box_length_y, int8_t bound_box_length_z, int16_t z_offset);
@@ -226,10 +316,34 @@ void paint_floating_money_effect(
 
 paint_session* paint_session_alloc(rct_drawpixelinfo* dpi, uint32_t viewFlags);
 void paint_session_free(paint_session* session);
+size_t paint_session_get_num_entries(const paint_session* session);
+void paint_session_record(const paint_session* session, RecordedPaintSession& recording);
 void paint_session_generate(paint_session* session);
 void paint_session_arrange(paint_session* session);
+void paint_session_arrange(paint_session* session, PaintSortMethod method);
 paint_struct* paint_arrange_structs_helper(paint_struct* ps_next, uint16_t quadrantIndex, uint8_t flag, uint8_t rotation);
 void paint_draw_structs(paint_session* session);
+void paint_session_replay_tile(paint_session* session, const PaintTileRecording& recording);
+void paint_session_set_tile_volatile(paint_session* session);
+
+/**
+ * Sets results[i - begin] to 1 for every candidate in [begin, end) that the quadrant sort has to draw before
+ * initialBBox in the given rotation, 0 otherwise.
+ */
+void paint_check_bounding_boxes_scalar(
+    uint8_t rotation, const paint_struct_bound_box& initialBBox, const PaintBoundsView& candidates, size_t begin, size_t end,
+    uint8_t* results);
+void paint_check_bounding_boxes_sse4_1(
+    uint8_t rotation, const paint_struct_bound_box& initialBBox, const PaintBoundsView& candidates, size_t begin, size_t end,
+    uint8_t* results);
+void paint_check_bounding_boxes_avx2(
+    uint8_t rotation, const paint_struct_bound_box& initialBBox, const PaintBoundsView& candidates, size_t begin, size_t end,
+    uint8_t* results);
+void paint_sort_init();
+
+extern void (*paint_check_bounding_boxes_fn)(
+    uint8_t rotation, const paint_struct_bound_box& initialBBox, const PaintBoundsView& candidates, size_t begin, size_t end,
+    uint8_t* results);
 void paint_draw_money_structs(rct_drawpixelinfo* dpi, paint_string_struct* ps);
 
 // TESTING
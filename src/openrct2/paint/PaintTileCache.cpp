@@ -0,0 +1,251 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "PaintTileCache.h"
+
+#include "../Cheats.h"
+#include "../OpenRCT2.h"
+#include "../config/Config.h"
+#include "../interface/Viewport.h"
+#include "../peep/Staff.h"
+#include "../ride/TrackDesign.h"
+#include "../world/Map.h"
+#include "VirtualFloor.h"
+#include "tile_element/Paint.TileElement.h"
+
+PaintTileCache gPaintTileCache;
+
+void PaintTileRecorder::Begin()
+{
+    _recording = std::make_shared<PaintTileRecording>();
+    _structs.clear();
+    _attached.clear();
+    _hasRoot = false;
+    _volatile = false;
+}
+
+void PaintTileRecorder::SetScreenExtent(int32_t screenBottom, int32_t screenTop)
+{
+    _recording->ScreenBottom = screenBottom;
+    _recording->ScreenTop = screenTop;
+    _recording->Painted = true;
+}
+
+void PaintTileRecorder::SetLastBounds(int32_t left, int32_t top, int32_t right, int32_t bottom)
+{
+    _lastBounds = { left, top, right, bottom };
+}
+
+void PaintTileRecorder::CheckPriorState()
+{
+    // Until the tile adds a root struct of its own, children and attachments go to whatever the previous tile or
+    // sprite left behind.
+    if (!_hasRoot)
+    {
+        _volatile = true;
+    }
+}
+
+void PaintTileRecorder::AddStruct(PaintTileCommandType type, paint_struct* ps)
+{
+    if (type == PaintTileCommandType::Root || type == PaintTileCommandType::RootUnlinked)
+    {
+        _hasRoot = true;
+    }
+
+    PaintTileCommand command = {};
+    command.Type = type;
+    command.HasStruct = ps != nullptr;
+    if (ps != nullptr)
+    {
+        command.Left = _lastBounds[0];
+        command.Top = _lastBounds[1];
+        command.Right = _lastBounds[2];
+        command.Bottom = _lastBounds[3];
+        command.Index = (uint32_t)_structs.size();
+        _structs.push_back(ps);
+    }
+    _recording->Commands.push_back(command);
+}
+
+void PaintTileRecorder::AddAttached(PaintTileCommandType type, attached_paint_struct* ps)
+{
+    PaintTileCommand command = {};
+    command.Type = type;
+    command.HasStruct = true;
+    command.Index = (uint32_t)_attached.size();
+    _attached.push_back(ps);
+    _recording->Commands.push_back(command);
+}
+
+std::shared_ptr<PaintTileRecording> PaintTileRecorder::Finish(const paint_session* session)
+{
+    auto recording = std::move(_recording);
+    if (_volatile)
+    {
+        return nullptr;
+    }
+
+    // Take the contents only now, element painters may still change a struct after it has been added.
+    recording->Structs.reserve(_structs.size());
+    for (auto ps : _structs)
+    {
+        recording->Structs.push_back(*ps);
+    }
+    recording->Attached.reserve(_attached.size());
+    for (auto ps : _attached)
+    {
+        recording->Attached.push_back(*ps);
+    }
+    recording->SurfaceElement = session->SurfaceElement;
+    return recording;
+}
+
+bool PaintTileCache::GlobalState::operator==(const GlobalState& other) const
+{
+    return ScreenFlags == other.ScreenFlags && ClipHeight == other.ClipHeight && ClipSelectionA == other.ClipSelectionA
+        && ClipSelectionB == other.ClipSelectionB && CheatsSandboxMode == other.CheatsSandboxMode
+        && LandscapeSmoothing == other.LandscapeSmoothing && PaintWidePathsAsGhost == other.PaintWidePathsAsGhost
+        && PaintBlockedTiles == other.PaintBlockedTiles && StaffDrawPatrolAreas == other.StaffDrawPatrolAreas;
+}
+
+PaintTileCache::GlobalState PaintTileCache::GetGlobalState()
+{
+    GlobalState state;
+    state.ScreenFlags = gScreenFlags;
+    state.ClipHeight = gClipHeight;
+    state.ClipSelectionA = gClipSelectionA;
+    state.ClipSelectionB = gClipSelectionB;
+    state.CheatsSandboxMode = gCheatsSandboxMode;
+    state.LandscapeSmoothing = gConfigGeneral.landscape_smoothing;
+    state.PaintWidePathsAsGhost = gPaintWidePathsAsGhost;
+    state.PaintBlockedTiles = gPaintBlockedTiles;
+    state.StaffDrawPatrolAreas = gStaffDrawPatrolAreas;
+    return state;
+}
+
+uint64_t PaintTileCache::GetViewKey(const paint_session* session)
+{
+    return session->ViewFlags | ((uint64_t)session->CurrentRotation << 32) | ((uint64_t)session->DPI.zoom_level << 34);
+}
+
+bool PaintTileCache::BeginPaint(uint32_t viewFlags)
+{
+    if (!_enabled)
+    {
+        return false;
+    }
+
+    if (_slots.empty())
+    {
+        _slots.resize(MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL);
+    }
+
+    auto globalState = GetGlobalState();
+    if (globalState != _globalState)
+    {
+        _globalState = globalState;
+        Flush();
+    }
+
+    // Tool overlays are painted as part of the tiles they cover and move without invalidating them.
+    if (gMapSelectFlags != 0 || virtual_floor_is_enabled() || gShowSupportSegmentHeights || gTrackDesignSaveMode)
+    {
+        return false;
+    }
+
+    // These views paint markers that restore LastRootPS directly, which can not be replayed.
+    if (viewFlags & (VIEWPORT_FLAG_LAND_OWNERSHIP | VIEWPORT_FLAG_CONSTRUCTION_RIGHTS))
+    {
+        return false;
+    }
+    return true;
+}
+
+void PaintTileCache::Flush()
+{
+    _flushGeneration++;
+}
+
+void PaintTileCache::SetEnabled(bool enabled)
+{
+    _enabled = enabled;
+    if (!enabled)
+    {
+        _slots.clear();
+        _slots.shrink_to_fit();
+    }
+    Flush();
+}
+
+bool PaintTileCache::Find(
+    const TileCoordsXY& tilePos, const paint_session* session, std::shared_ptr<const PaintTileRecording>& recording)
+{
+    if (tilePos.x < 0 || tilePos.y < 0 || tilePos.x >= MAXIMUM_MAP_SIZE_TECHNICAL || tilePos.y >= MAXIMUM_MAP_SIZE_TECHNICAL)
+    {
+        return false;
+    }
+
+    size_t index = tilePos.y * MAXIMUM_MAP_SIZE_TECHNICAL + tilePos.x;
+    std::lock_guard<std::mutex> lock(_locks[index % NumLocks]);
+    const auto& slot = _slots[index];
+    if (slot.FlushGeneration != _flushGeneration || slot.Generation != map_get_tile_generation(tilePos)
+        || slot.ViewKey != GetViewKey(session))
+    {
+        _numMisses++;
+        return false;
+    }
+    _numHits++;
+    recording = slot.Recording;
+    return true;
+}
+
+void PaintTileCache::Store(
+    const TileCoordsXY& tilePos, const paint_session* session, std::shared_ptr<const PaintTileRecording> recording)
+{
+    if (tilePos.x < 0 || tilePos.y < 0 || tilePos.x >= MAXIMUM_MAP_SIZE_TECHNICAL || tilePos.y >= MAXIMUM_MAP_SIZE_TECHNICAL)
+    {
+        return;
+    }
+
+    size_t index = tilePos.y * MAXIMUM_MAP_SIZE_TECHNICAL + tilePos.x;
+    std::lock_guard<std::mutex> lock(_locks[index % NumLocks]);
+    auto& slot = _slots[index];
+    slot.FlushGeneration = _flushGeneration;
+    slot.Generation = map_get_tile_generation(tilePos);
+    slot.ViewKey = GetViewKey(session);
+    slot.Recording = std::move(recording);
+}
+
+bool PaintTileCache::IsTileCacheable(const TileCoordsXY& tilePos)
+{
+    const TileElement* element = map_get_first_element_at(tilePos.ToCoordsXY());
+    if (element == nullptr || element->GetType() != TILE_ELEMENT_TYPE_SURFACE)
+    {
+        // Elements below the surface would see the surface element of the previous tile.
+        return false;
+    }
+
+    do
+    {
+        switch (element->GetType())
+        {
+            case TILE_ELEMENT_TYPE_SURFACE:
+            case TILE_ELEMENT_TYPE_PATH:
+            case TILE_ELEMENT_TYPE_SMALL_SCENERY:
+            case TILE_ELEMENT_TYPE_WALL:
+            case TILE_ELEMENT_TYPE_LARGE_SCENERY:
+                break;
+            default:
+                // Tracks and entrances depend on ride state, banners on their text.
+                return false;
+        }
+    } while (!(element++)->IsLastForTile());
+    return true;
+}
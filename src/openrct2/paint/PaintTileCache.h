@@ -0,0 +1,196 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "../world/Location.hpp"
+#include "Paint.h"
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+struct TileElement;
+
+enum class PaintTileCommandType : uint8_t
+{
+    // sub_98196C and sub_98197C, a new root struct added to a quadrant.
+    Root,
+    // sub_98198C, a new root struct that is not added to any quadrant.
+    RootUnlinked,
+    // sub_98199C while there was a root struct to add it to.
+    Child,
+    // paint_attach_to_previous_ps
+    AttachToPS,
+    // paint_attach_to_previous_attach while there was an attached struct to add it to.
+    AttachToAttach,
+};
+
+struct PaintTileCommand
+{
+    PaintTileCommandType Type;
+    // False if the call produced no struct regardless of the view, e.g. because the image does not exist.
+    bool HasStruct;
+    // Screen rectangle of the image, used to cull the struct against the view being painted.
+    int32_t Left;
+    int32_t Top;
+    int32_t Right;
+    int32_t Bottom;
+    // Index into PaintTileRecording::Structs or PaintTileRecording::Attached.
+    uint32_t Index;
+};
+
+/**
+ * The sequence of paint calls made by a tile, recorded without any clipping so it can be replayed into any view of
+ * the same rotation and zoom. Structs hold their contents as they were after the whole tile was painted, which
+ * includes anything the element painters wrote to a struct after creating it.
+ */
+struct PaintTileRecording
+{
+    // The tile is not painted at all when ScreenBottom <= dpi y or ScreenTop - dpi height >= dpi y.
+    int32_t ScreenBottom = 0;
+    int32_t ScreenTop = 0;
+    bool Painted = false;
+    std::vector<PaintTileCommand> Commands;
+    std::vector<paint_struct> Structs;
+    std::vector<attached_paint_struct> Attached;
+    const TileElement* SurfaceElement = nullptr;
+};
+
+/**
+ * Collects the paint calls of a single tile while it is being painted into a scratch session.
+ */
+class PaintTileRecorder
+{
+public:
+    void Begin();
+    void SetScreenExtent(int32_t screenBottom, int32_t screenTop);
+    void SetLastBounds(int32_t left, int32_t top, int32_t right, int32_t bottom);
+    void CheckPriorState();
+    void AddStruct(PaintTileCommandType type, paint_struct* ps);
+    void AddAttached(PaintTileCommandType type, attached_paint_struct* ps);
+
+    /**
+     * Marks the tile as one whose output can not be reused, either because it depends on state left behind by the
+     * previous tile or because it changes without the tile being invalidated, e.g. animations.
+     */
+    void SetVolatile()
+    {
+        _volatile = true;
+    }
+
+    bool IsVolatile() const
+    {
+        return _volatile;
+    }
+
+    std::shared_ptr<PaintTileRecording> Finish(const paint_session* session);
+
+private:
+    std::shared_ptr<PaintTileRecording> _recording;
+    std::vector<paint_struct*> _structs;
+    std::vector<attached_paint_struct*> _attached;
+    std::array<int32_t, 4> _lastBounds{};
+    bool _hasRoot = false;
+    bool _volatile = false;
+};
+
+/**
+ * Per tile cache of paint output for the main viewports. An entry is valid for as long as the tile's modification
+ * generation and the view it was recorded for are unchanged. Moving sprites are always painted live.
+ */
+class PaintTileCache
+{
+public:
+    /**
+     * Prepares the cache for painting a view. Returns false if the cache can not be used for the view or the current
+     * state of the game, e.g. while a tool shows a map selection.
+     */
+    bool BeginPaint(uint32_t viewFlags);
+
+    /**
+     * Drops all cached tiles.
+     */
+    void Flush();
+
+    /**
+     * Looks up the recording of a tile. Returns true if there is a valid entry, in which case recording is set to
+     * the cached output or nullptr if the tile is known to need painting live.
+     */
+    bool Find(const TileCoordsXY& tilePos, const paint_session* session, std::shared_ptr<const PaintTileRecording>& recording);
+    void Store(const TileCoordsXY& tilePos, const paint_session* session, std::shared_ptr<const PaintTileRecording> recording);
+
+    /**
+     * Returns true if every element on the tile is of a type whose painting only depends on the tile itself.
+     */
+    static bool IsTileCacheable(const TileCoordsXY& tilePos);
+
+    bool IsEnabled() const
+    {
+        return _enabled;
+    }
+
+    void SetEnabled(bool enabled);
+
+    uint64_t GetNumHits() const
+    {
+        return _numHits;
+    }
+
+    uint64_t GetNumMisses() const
+    {
+        return _numMisses;
+    }
+
+private:
+    struct Slot
+    {
+        uint32_t Generation = 0;
+        uint32_t FlushGeneration = 0;
+        uint64_t ViewKey = 0;
+        std::shared_ptr<const PaintTileRecording> Recording;
+    };
+
+    struct GlobalState
+    {
+        uint8_t ScreenFlags;
+        uint8_t ClipHeight;
+        TileCoordsXY ClipSelectionA;
+        TileCoordsXY ClipSelectionB;
+        bool CheatsSandboxMode;
+        bool LandscapeSmoothing;
+        bool PaintWidePathsAsGhost;
+        bool PaintBlockedTiles;
+        uint16_t StaffDrawPatrolAreas;
+
+        bool operator==(const GlobalState& other) const;
+        bool operator!=(const GlobalState& other) const
+        {
+            return !(*this == other);
+        }
+    };
+
+    static constexpr size_t NumLocks = 64;
+
+    static uint64_t GetViewKey(const paint_session* session);
+    static GlobalState GetGlobalState();
+
+    bool _enabled = false;
+    std::vector<Slot> _slots;
+    std::array<std::mutex, NumLocks> _locks;
+    std::atomic<uint32_t> _flushGeneration = { 1 };
+    GlobalState _globalState{};
+    std::atomic<uint64_t> _numHits = { 0 };
+    std::atomic<uint64_t> _numMisses = { 0 };
+};
+
+extern PaintTileCache gPaintTileCache;
@@ -163,8 +163,9 @@ paint_session* Painter::CreateSession(rct_drawpixelinfo* dpi, uint32_t viewFlags
     }
 
     session->DPI = *dpi;
-    session->EndOfPaintStructArray = &session->PaintStructs[4000 - 1];
-    session->NextFreePaintStruct = session->PaintStructs;
+    session->PaintEntries.Reset();
+    session->EndOfPaintStructArray = nullptr;
+    session->NextFreePaintStruct = nullptr;
     session->LastRootPS = nullptr;
     session->UnkF1AD2C = nullptr;
     session->ViewFlags = viewFlags;
@@ -179,11 +180,29 @@ paint_session* Painter::CreateSession(rct_drawpixelinfo* dpi, uint32_t viewFlags
     session->WoodenSupportsPrependTo = nullptr;
     session->CurrentlyDrawnItem = nullptr;
     session->SurfaceElement = nullptr;
+    session->TileCache = nullptr;
+    session->TileRecorder = nullptr;
 
     return session;
 }
 
 void Painter::ReleaseSession(paint_session* session)
 {
+    _peakPaintEntries = std::max(_peakPaintEntries, paint_session_get_num_entries(session));
     _freePaintSessions.push_back(session);
 }
+
+size_t Painter::GetPeakPaintEntries() const
+{
+    return _peakPaintEntries;
+}
+
+size_t Painter::GetPaintEntryMemoryUsage() const
+{
+    size_t numChunks = 0;
+    for (const auto& session : _paintSessionPool)
+    {
+        numChunks += session->PaintEntries.GetNumChunksAllocated();
+    }
+    return numChunks * PaintEntryArena::ChunkSize * sizeof(paint_entry);
+}
@@ -41,6 +41,7 @@ namespace OpenRCT2
             time_t _lastSecond = 0;
             int32_t _currentFPS = 0;
             int32_t _frames = 0;
+            size_t _peakPaintEntries = 0;
 
         public:
             explicit Painter(const std::shared_ptr<Ui::IUiContext>& uiContext);
@@ -49,6 +50,16 @@ namespace OpenRCT2
             paint_session* CreateSession(rct_drawpixelinfo * dpi, uint32_t viewFlags);
             void ReleaseSession(paint_session * session);
 
+            /**
+             * Returns the highest number of paint entries a single session has used so far.
+             */
+            size_t GetPeakPaintEntries() const;
+
+            /**
+             * Returns the number of bytes currently held by the paint entry arenas of all pooled sessions.
+             */
+            size_t GetPaintEntryMemoryUsage() const;
+
         private:
             void PaintReplayNotice(rct_drawpixelinfo * dpi, const char* text);
             void PaintFPS(rct_drawpixelinfo * dpi);
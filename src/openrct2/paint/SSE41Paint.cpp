@@ -0,0 +1,84 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "../common.h"
+#include "../core/Guard.hpp"
+#include "Paint.h"
+
+#ifdef __SSE4_1__
+
+#    include <immintrin.h>
+
+// Unsigned a >= b per 16-bit lane, _mm_max_epu16 is SSE4.1
+static inline __m128i paint_cmpge_epu16(__m128i a, __m128i b)
+{
+    return _mm_cmpeq_epi16(_mm_max_epu16(a, b), a);
+}
+
+void paint_check_bounding_boxes_sse4_1(
+    uint8_t rotation, const paint_struct_bound_box& initialBBox, const PaintBoundsView& candidates, size_t begin, size_t end,
+    uint8_t* results)
+{
+    // Mirrors check_bounding_box<rotation>: rotations 1 and 2 flip the x comparisons, rotations 2 and 3 flip y.
+    const __m128i allSet = _mm_set1_epi16(-1);
+    const __m128i flipX = (rotation == 1 || rotation == 2) ? allSet : _mm_setzero_si128();
+    const __m128i flipY = (rotation == 2 || rotation == 3) ? allSet : _mm_setzero_si128();
+    const __m128i notFlipX = _mm_xor_si128(flipX, allSet);
+    const __m128i notFlipY = _mm_xor_si128(flipY, allSet);
+
+    const __m128i initialX = _mm_set1_epi16((int16_t)initialBBox.x);
+    const __m128i initialY = _mm_set1_epi16((int16_t)initialBBox.y);
+    const __m128i initialZ = _mm_set1_epi16((int16_t)initialBBox.z);
+    const __m128i initialXEnd = _mm_set1_epi16((int16_t)initialBBox.x_end);
+    const __m128i initialYEnd = _mm_set1_epi16((int16_t)initialBBox.y_end);
+    const __m128i initialZEnd = _mm_set1_epi16((int16_t)initialBBox.z_end);
+    const __m128i one = _mm_set1_epi8(1);
+
+    size_t i = begin;
+    for (; i + 8 <= end; i += 8)
+    {
+        const __m128i x = _mm_loadu_si128((const __m128i*)(candidates.X + i));
+        const __m128i y = _mm_loadu_si128((const __m128i*)(candidates.Y + i));
+        const __m128i z = _mm_loadu_si128((const __m128i*)(candidates.Z + i));
+        const __m128i xEnd = _mm_loadu_si128((const __m128i*)(candidates.XEnd + i));
+        const __m128i yEnd = _mm_loadu_si128((const __m128i*)(candidates.YEnd + i));
+        const __m128i zEnd = _mm_loadu_si128((const __m128i*)(candidates.ZEnd + i));
+
+        const __m128i behindX = _mm_xor_si128(paint_cmpge_epu16(initialXEnd, x), flipX);
+        const __m128i behindY = _mm_xor_si128(paint_cmpge_epu16(initialYEnd, y), flipY);
+        const __m128i behindZ = paint_cmpge_epu16(initialZEnd, z);
+        const __m128i overlapX = _mm_xor_si128(paint_cmpge_epu16(initialX, xEnd), notFlipX);
+        const __m128i overlapY = _mm_xor_si128(paint_cmpge_epu16(initialY, yEnd), notFlipY);
+        const __m128i overlapZ = _mm_xor_si128(paint_cmpge_epu16(initialZ, zEnd), allSet);
+
+        const __m128i behind = _mm_and_si128(behindX, _mm_and_si128(behindY, behindZ));
+        const __m128i overlap = _mm_and_si128(overlapX, _mm_and_si128(overlapY, overlapZ));
+        const __m128i result = _mm_andnot_si128(overlap, behind);
+
+        // Narrow the 16-bit lane masks to one byte per candidate.
+        const __m128i bytes = _mm_and_si128(_mm_packs_epi16(result, _mm_setzero_si128()), one);
+        _mm_storel_epi64((__m128i*)(results + (i - begin)), bytes);
+    }
+    paint_check_bounding_boxes_scalar(rotation, initialBBox, candidates, i, end, results + (i - begin));
+}
+
+#else
+
+#    ifdef OPENRCT2_X86
+#        error You have to compile this file with SSE4.1 enabled, when targetting x86!
+#    endif
+
+void paint_check_bounding_boxes_sse4_1(
+    uint8_t rotation, const paint_struct_bound_box& initialBBox, const PaintBoundsView& candidates, size_t begin, size_t end,
+    uint8_t* results)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+}
+
+#endif // __SSE4_1__
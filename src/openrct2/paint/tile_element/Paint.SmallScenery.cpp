@@ -176,6 +176,9 @@ void scenery_paint(paint_session* session, uint8_t direction, int32_t height, co
 
     if (scenery_small_entry_has_flag(entry, SMALL_SCENERY_FLAG_ANIMATED))
     {
+        // Animation frames follow the tick count rather than tile invalidation.
+        paint_session_set_tile_volatile(session);
+
         rct_drawpixelinfo* dpi = &session->DPI;
         if ((scenery_small_entry_has_flag(entry, SMALL_SCENERY_FLAG_VISIBLE_WHEN_ZOOMED)) || (dpi->zoom_level <= 1))
         {
@@ -26,11 +26,14 @@
 #include "../../world/Sprite.h"
 #include "../../world/Surface.h"
 #include "../Paint.h"
+#include "../PaintTileCache.h"
 #include "../Supports.h"
 #include "../VirtualFloor.h"
 #include "Paint.Surface.h"
 
 #include <algorithm>
+#include <limits>
+#include <memory>
 
 #ifdef __TESTPAINT__
 uint16_t testPaintVerticalTunnelHeight;
@@ -38,6 +41,9 @@ uint16_t testPaintVerticalTunnelHeight;
 
 static void blank_tiles_paint(paint_session* session, int32_t x, int32_t y);
 static void sub_68B3FB(paint_session* session, int32_t x, int32_t y);
+#ifndef __TESTPAINT__
+static bool tile_element_paint_from_cache(paint_session* session, int32_t x, int32_t y);
+#endif // __TESTPAINT__
 
 const int32_t SEGMENTS_ALL = SEGMENT_B4 | SEGMENT_B8 | SEGMENT_BC | SEGMENT_C0 | SEGMENT_C4 | SEGMENT_C8 | SEGMENT_CC
     | SEGMENT_D0 | SEGMENT_D4;
@@ -55,6 +61,12 @@ void tile_element_paint_setup(paint_session* session, int32_t x, int32_t y)
         session->Unk141E9DB = 0;
         session->WaterHeight = 0xFFFF;
 
+#ifndef __TESTPAINT__
+        if (session->TileCache != nullptr && tile_element_paint_from_cache(session, x, y))
+        {
+            return;
+        }
+#endif // __TESTPAINT__
         sub_68B3FB(session, x, y);
     }
     else if (!(session->ViewFlags & VIEWPORT_FLAG_TRANSPARENT_BACKGROUND))
@@ -130,6 +142,89 @@ static void blank_tiles_paint(paint_session* session, int32_t x, int32_t y)
 
 bool gShowSupportSegmentHeights = false;
 
+#ifndef __TESTPAINT__
+static thread_local std::unique_ptr<paint_session> _tileRecordSession;
+static thread_local PaintTileRecorder _tileRecorder;
+
+/**
+ * Paints a tile into a scratch session that covers the whole map, so the recording can be replayed into any view
+ * of the same rotation and zoom. Returns nullptr if the tile's output can not be reused.
+ */
+static std::shared_ptr<PaintTileRecording> tile_element_paint_record(paint_session* session, int32_t x, int32_t y)
+{
+    if (_tileRecordSession == nullptr)
+    {
+        _tileRecordSession = std::make_unique<paint_session>();
+    }
+
+    paint_session* recordSession = _tileRecordSession.get();
+    recordSession->DPI = session->DPI;
+    recordSession->DPI.x = std::numeric_limits<int16_t>::min() / 2;
+    recordSession->DPI.y = std::numeric_limits<int16_t>::min() / 2;
+    recordSession->DPI.width = std::numeric_limits<int16_t>::max();
+    recordSession->DPI.height = std::numeric_limits<int16_t>::max();
+    recordSession->PaintEntries.Reset();
+    recordSession->EndOfPaintStructArray = nullptr;
+    recordSession->NextFreePaintStruct = nullptr;
+    recordSession->LastRootPS = nullptr;
+    recordSession->UnkF1AD2C = nullptr;
+    recordSession->ViewFlags = session->ViewFlags;
+    recordSession->CurrentRotation = session->CurrentRotation;
+    std::fill(std::begin(recordSession->Quadrants), std::end(recordSession->Quadrants), nullptr);
+    recordSession->QuadrantBackIndex = std::numeric_limits<uint32_t>::max();
+    recordSession->QuadrantFrontIndex = 0;
+    recordSession->PSStringHead = nullptr;
+    recordSession->LastPSString = nullptr;
+    recordSession->WoodenSupportsPrependTo = nullptr;
+    recordSession->CurrentlyDrawnItem = nullptr;
+    recordSession->SurfaceElement = nullptr;
+    recordSession->InteractionType = session->InteractionType;
+    recordSession->TileCache = nullptr;
+    recordSession->TileRecorder = &_tileRecorder;
+
+    paint_util_set_segment_support_height(recordSession, SEGMENTS_ALL, 0xFFFF, 0);
+    paint_util_force_set_general_support_height(recordSession, -1, 0);
+    recordSession->Unk141E9DB = 0;
+    recordSession->WaterHeight = 0xFFFF;
+
+    _tileRecorder.Begin();
+    sub_68B3FB(recordSession, x, y);
+    return _tileRecorder.Finish(recordSession);
+}
+
+/**
+ * Paints a tile from the paint tile cache, recording it first if needed. Returns false if the tile has to be
+ * painted live.
+ */
+static bool tile_element_paint_from_cache(paint_session* session, int32_t x, int32_t y)
+{
+    // Wooden supports may add their structs as children of a track piece painted earlier.
+    if (session->WoodenSupportsPrependTo != nullptr)
+    {
+        return false;
+    }
+
+    auto cache = session->TileCache;
+    auto tilePos = TileCoordsXY(CoordsXY{ x, y });
+    std::shared_ptr<const PaintTileRecording> recording;
+    if (!cache->Find(tilePos, session, recording))
+    {
+        if (PaintTileCache::IsTileCacheable(tilePos))
+        {
+            recording = tile_element_paint_record(session, x, y);
+        }
+        cache->Store(tilePos, session, recording);
+    }
+
+    if (recording == nullptr)
+    {
+        return false;
+    }
+    paint_session_replay_tile(session, *recording);
+    return true;
+}
+#endif // __TESTPAINT__
+
 /**
  *
  *  rct2: 0x0068B3FB
@@ -235,6 +330,13 @@ static void sub_68B3FB(paint_session* session, int32_t x, int32_t y)
 
     dx -= max_height + 32;
 
+#ifndef __TESTPAINT__
+    if (session->TileRecorder != nullptr)
+    {
+        session->TileRecorder->SetScreenExtent(bx, dx);
+    }
+#endif // __TESTPAINT__
+
     element = tile_element; // pop tile_element
     dx -= dpi->height;
     if (dx >= dpi->y)
@@ -168,6 +168,7 @@ void fence_paint(paint_session* session, uint8_t direction, int32_t height, cons
     if (sceneryEntry->wall.flags2 & WALL_SCENERY_2_ANIMATED)
     {
         frameNum = (gCurrentTicks & 7) * 2;
+        paint_session_set_tile_volatile(session);
     }
 
     int32_t primaryColour = tile_element->AsWall()->GetPrimaryColour();
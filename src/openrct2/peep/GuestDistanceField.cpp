@@ -0,0 +1,290 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "GuestDistanceField.h"
+
+#include "../ride/Ride.h"
+#include "../world/Entrance.h"
+#include "../world/Footpath.h"
+#include "../world/FootpathGraph.h"
+#include "../world/Map.h"
+#include "Peep.h"
+
+GuestDistanceFieldCache gGuestDistanceFields;
+
+static uint32_t GetNodeKey(const TileCoordsXYZ& loc)
+{
+    return ((uint32_t)(uint8_t)loc.x << 16) | ((uint32_t)(uint8_t)loc.y << 8) | (uint32_t)(uint8_t)loc.z;
+}
+
+static bool IsLocationInMap(const TileCoordsXY& loc)
+{
+    return loc.x >= 0 && loc.y >= 0 && loc.x < gMapSize && loc.y < gMapSize;
+}
+
+/**
+ * Whether walking onto loc in the given direction reaches a goal that is not a path, i.e. a ride entrance or exit
+ * facing the right way, a park entrance or a shop. Matches what the heuristic search counts as reaching the goal.
+ */
+static bool step_reaches_goal_element(const TileCoordsXYZ& loc, Direction direction, const TileCoordsXYZ& goal)
+{
+    if (!(loc == goal))
+        return false;
+
+    TileElement* tileElement = map_get_first_element_at(loc.ToCoordsXY());
+    if (tileElement == nullptr)
+        return false;
+    do
+    {
+        if (tileElement->IsGhost() || tileElement->base_height != loc.z)
+            continue;
+
+        switch (tileElement->GetType())
+        {
+            case TILE_ELEMENT_TYPE_TRACK:
+            {
+                auto ride = get_ride(tileElement->AsTrack()->GetRideIndex());
+                if (ride != nullptr && ride_type_has_flag(ride->type, RIDE_TYPE_FLAG_IS_SHOP))
+                    return true;
+                break;
+            }
+            case TILE_ELEMENT_TYPE_ENTRANCE:
+                switch (tileElement->AsEntrance()->GetEntranceType())
+                {
+                    case ENTRANCE_TYPE_RIDE_ENTRANCE:
+                    case ENTRANCE_TYPE_RIDE_EXIT:
+                        if (tileElement->GetDirection() == direction)
+                            return true;
+                        break;
+                    case ENTRANCE_TYPE_PARK_ENTRANCE:
+                        return true;
+                }
+                break;
+        }
+    } while (!(tileElement++)->IsLastForTile());
+    return false;
+}
+
+void GuestDistanceFieldCache::SetEnabled(bool enabled)
+{
+    _enabled = enabled;
+    _isBuilt = false;
+    _nodes.clear();
+    _nodes.shrink_to_fit();
+    _nodeIndices.clear();
+    _reverseLinkStart.clear();
+    _reverseLinkStart.shrink_to_fit();
+    _reverseLinks.clear();
+    _reverseLinks.shrink_to_fit();
+    _fields.clear();
+}
+
+void GuestDistanceFieldCache::Validate()
+{
+    auto generation = gFootpathGraph.GetGeneration();
+    if (_isBuilt && _builtGeneration == generation)
+        return;
+
+    _fields.clear();
+    BuildNetwork();
+    _builtGeneration = generation;
+    _isBuilt = true;
+}
+
+void GuestDistanceFieldCache::BuildNetwork()
+{
+    _nodes.clear();
+    _nodeIndices.clear();
+
+    std::vector<PathElement*> pathElements;
+    for (int32_t y = 0; y < gMapSize; y++)
+    {
+        for (int32_t x = 0; x < gMapSize; x++)
+        {
+            TileElement* tileElement = map_get_first_element_at(TileCoordsXY{ x, y }.ToCoordsXY());
+            if (tileElement == nullptr)
+                continue;
+            do
+            {
+                if (tileElement->GetType() != TILE_ELEMENT_TYPE_PATH || tileElement->IsGhost())
+                    continue;
+
+                auto path = tileElement->AsPath();
+                Node node;
+                node.Location = { x, y, path->base_height };
+                node.QueueRideIndex = path->IsQueue() ? path->GetRideIndex() : RIDE_ID_NULL;
+                node.PermittedEdges = path_get_guest_permitted_edges(path);
+                // Overlaid paths at the same height are merged into one node, as peep_pathfind_choose_direction does.
+                auto result = _nodeIndices.emplace(GetNodeKey(node.Location), (uint32_t)_nodes.size());
+                if (!result.second)
+                {
+                    _nodes[result.first->second].PermittedEdges |= node.PermittedEdges;
+                    continue;
+                }
+                _nodes.push_back(node);
+                pathElements.push_back(path);
+            } while (!(tileElement++)->IsLastForTile());
+        }
+    }
+
+    // Work out the links leaving every node, then store them by the node they lead into for the search.
+    std::vector<std::pair<uint32_t, Link>> links;
+    for (uint32_t i = 0; i < _nodes.size(); i++)
+    {
+        const auto& node = _nodes[i];
+        auto path = pathElements[i];
+        for (Direction direction : ALL_DIRECTIONS)
+        {
+            if (!(node.PermittedEdges & (1 << direction)))
+                continue;
+
+            uint8_t height = node.Location.z;
+            if (path->IsSloped() && path->GetSlopeDirection() == direction)
+            {
+                height += 2;
+            }
+            TileCoordsXYZ nextLoc = { node.Location.x + TileDirectionDelta[direction].x,
+                                      node.Location.y + TileDirectionDelta[direction].y, height };
+            if (!IsLocationInMap(nextLoc))
+                continue;
+
+            TileElement* tileElement = map_get_first_element_at(nextLoc.ToCoordsXY());
+            if (tileElement == nullptr)
+                continue;
+            do
+            {
+                if (tileElement->GetType() != TILE_ELEMENT_TYPE_PATH || tileElement->IsGhost())
+                    continue;
+                if (!is_valid_path_z_and_direction(tileElement, nextLoc.z, direction))
+                    continue;
+                auto nextNode = FindNode({ nextLoc.x, nextLoc.y, tileElement->base_height });
+                if (nextNode != NoNode)
+                {
+                    links.push_back({ nextNode, { i, direction } });
+                }
+            } while (!(tileElement++)->IsLastForTile());
+        }
+    }
+
+    _reverseLinkStart.assign(_nodes.size() + 1, 0);
+    for (const auto& link : links)
+    {
+        _reverseLinkStart[link.first + 1]++;
+    }
+    for (size_t i = 0; i < _nodes.size(); i++)
+    {
+        _reverseLinkStart[i + 1] += _reverseLinkStart[i];
+    }
+    _reverseLinks.resize(links.size());
+    std::vector<uint32_t> fill(_reverseLinkStart.begin(), _reverseLinkStart.end() - 1);
+    for (const auto& link : links)
+    {
+        _reverseLinks[fill[link.first]++] = link.second;
+    }
+}
+
+uint32_t GuestDistanceFieldCache::FindNode(const TileCoordsXYZ& loc) const
+{
+    if (!IsLocationInMap(loc))
+        return NoNode;
+    auto it = _nodeIndices.find(GetNodeKey(loc));
+    return it == _nodeIndices.end() ? NoNode : it->second;
+}
+
+std::vector<Direction> GuestDistanceFieldCache::BuildField(const FieldKey& key) const
+{
+    std::vector<Direction> directions(_nodes.size(), INVALID_DIRECTION);
+    std::vector<bool> reached(_nodes.size(), false);
+    std::vector<uint32_t> queue;
+
+    // Either the goal is a path itself, or it is an element next to the paths that lead onto it.
+    auto goalNode = FindNode(key.Goal);
+    if (goalNode != NoNode)
+    {
+        reached[goalNode] = true;
+        queue.push_back(goalNode);
+    }
+    for (Direction direction : ALL_DIRECTIONS)
+    {
+        TileCoordsXY fromLoc = { key.Goal.x - TileDirectionDelta[direction].x, key.Goal.y - TileDirectionDelta[direction].y };
+        if (!IsLocationInMap(fromLoc))
+            continue;
+
+        TileElement* tileElement = map_get_first_element_at(fromLoc.ToCoordsXY());
+        if (tileElement == nullptr)
+            continue;
+        do
+        {
+            if (tileElement->GetType() != TILE_ELEMENT_TYPE_PATH || tileElement->IsGhost())
+                continue;
+            auto fromNode = FindNode({ fromLoc.x, fromLoc.y, tileElement->base_height });
+            if (fromNode == NoNode || reached[fromNode] || !(_nodes[fromNode].PermittedEdges & (1 << direction)))
+                continue;
+
+            auto path = tileElement->AsPath();
+            uint8_t height = path->base_height;
+            if (path->IsSloped() && path->GetSlopeDirection() == direction)
+            {
+                height += 2;
+            }
+            if (step_reaches_goal_element({ key.Goal.x, key.Goal.y, height }, direction, key.Goal))
+            {
+                reached[fromNode] = true;
+                directions[fromNode] = direction;
+                queue.push_back(fromNode);
+            }
+        } while (!(tileElement++)->IsLastForTile());
+    }
+
+    // Breadth first search backwards from the goal, every node reached points at the node it was reached from.
+    for (size_t head = 0; head < queue.size(); head++)
+    {
+        auto nodeIndex = queue[head];
+        const auto& node = _nodes[nodeIndex];
+
+        // Guests do not walk through the queues of rides they are not heading for.
+        bool isForeignQueue = key.IgnoreForeignQueues && node.QueueRideIndex != RIDE_ID_NULL
+            && node.QueueRideIndex != key.QueueRideIndex;
+        if (isForeignQueue && nodeIndex != goalNode)
+            continue;
+
+        for (auto i = _reverseLinkStart[nodeIndex]; i < _reverseLinkStart[nodeIndex + 1]; i++)
+        {
+            const auto& link = _reverseLinks[i];
+            if (reached[link.Node])
+                continue;
+            reached[link.Node] = true;
+            directions[link.Node] = link.Dir;
+            queue.push_back(link.Node);
+        }
+    }
+    return directions;
+}
+
+Direction GuestDistanceFieldCache::GetDirection(
+    const TileCoordsXYZ& loc, const TileCoordsXYZ& goal, ride_id_t queueRideIndex, bool ignoreForeignQueues)
+{
+    Validate();
+
+    auto nodeIndex = FindNode(loc);
+    if (nodeIndex == NoNode)
+        return INVALID_DIRECTION;
+
+    FieldKey key = { goal, queueRideIndex, ignoreForeignQueues };
+    auto it = _fields.find(key);
+    if (it == _fields.end())
+    {
+        if (_fields.size() >= MaxFields)
+        {
+            _fields.clear();
+        }
+        it = _fields.emplace(key, BuildField(key)).first;
+    }
+    return it->second[nodeIndex];
+}
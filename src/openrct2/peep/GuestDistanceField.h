@@ -0,0 +1,111 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "../ride/RideTypes.h"
+#include "../world/Location.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Shortest walks along the footpath network to the goals guests head for (ride entrances, queue ends and park
+ * exits). Each goal gets a field holding, for every path element, the direction of the first step of a shortest walk
+ * to it. Fields are worked out with a breadth first search the first time a guest asks for a goal and are shared by
+ * every guest heading there, until anything on the footpath network changes.
+ */
+class GuestDistanceFieldCache
+{
+public:
+    static constexpr size_t MaxFields = 256;
+
+    bool IsEnabled() const
+    {
+        return _enabled;
+    }
+
+    void SetEnabled(bool enabled);
+
+    /**
+     * Returns the direction of the first step from the path at loc towards goal, or INVALID_DIRECTION if there is no
+     * path at loc or no walk from it reaches goal.
+     */
+    Direction GetDirection(
+        const TileCoordsXYZ& loc, const TileCoordsXYZ& goal, ride_id_t queueRideIndex, bool ignoreForeignQueues);
+
+    size_t GetNumFields() const
+    {
+        return _fields.size();
+    }
+
+    size_t GetNumNodes() const
+    {
+        return _nodes.size();
+    }
+
+private:
+    struct Node
+    {
+        TileCoordsXYZ Location;
+        ride_id_t QueueRideIndex;
+        uint8_t PermittedEdges;
+    };
+
+    struct Link
+    {
+        uint32_t Node;
+        Direction Dir;
+    };
+
+    struct FieldKey
+    {
+        TileCoordsXYZ Goal;
+        ride_id_t QueueRideIndex;
+        bool IgnoreForeignQueues;
+
+        bool operator==(const FieldKey& other) const
+        {
+            return Goal == other.Goal && QueueRideIndex == other.QueueRideIndex
+                && IgnoreForeignQueues == other.IgnoreForeignQueues;
+        }
+    };
+
+    struct FieldKeyHash
+    {
+        size_t operator()(const FieldKey& key) const
+        {
+            uint32_t goal = ((uint32_t)(uint8_t)key.Goal.x << 16) | ((uint32_t)(uint8_t)key.Goal.y << 8)
+                | (uint32_t)(uint8_t)key.Goal.z;
+            return (size_t)(goal ^ ((uint32_t)key.QueueRideIndex << 24) ^ ((uint32_t)key.IgnoreForeignQueues << 23));
+        }
+    };
+
+    static constexpr uint32_t NoNode = std::numeric_limits<uint32_t>::max();
+
+    void Validate();
+    void BuildNetwork();
+    uint32_t FindNode(const TileCoordsXYZ& loc) const;
+    std::vector<Direction> BuildField(const FieldKey& key) const;
+
+    bool _enabled = false;
+    uint32_t _builtGeneration = 0;
+    bool _isBuilt = false;
+    std::vector<Node> _nodes;
+    std::unordered_map<uint32_t, uint32_t> _nodeIndices;
+    // Links into each node, _reverseLinks[_reverseLinkStart[i] .. _reverseLinkStart[i + 1]] lead into node i.
+    std::vector<uint32_t> _reverseLinkStart;
+    std::vector<Link> _reverseLinks;
+    std::unordered_map<FieldKey, std::vector<Direction>, FieldKeyHash> _fields;
+};
+
+extern GuestDistanceFieldCache gGuestDistanceFields;
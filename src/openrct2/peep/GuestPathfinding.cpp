@@ -8,18 +8,22 @@
  *****************************************************************************/
 
 #include "../core/Guard.hpp"
+#include "../network/network.h"
 #include "../ride/Station.h"
 #include "../ride/Track.h"
 #include "../scenario/Scenario.h"
 #include "../util/Util.h"
 #include "../world/Entrance.h"
 #include "../world/Footpath.h"
+#include "../world/FootpathGraph.h"
+#include "GuestDistanceField.h"
 #include "Peep.h"
 #include "Staff.h"
 
 #include <cstring>
 
 static bool _peepPathFindIsStaff;
+static bool _peepPathFindUseGraph;
 static int8_t _peepPathFindNumJunctions;
 static int8_t _peepPathFindMaxJunctions;
 static int32_t _peepPathFindTilesChecked;
@@ -79,10 +83,8 @@ static TileElement* get_banner_on_path(TileElement* path_element)
     return nullptr;
 }
 
-static int32_t banner_clear_path_edges(PathElement* pathElement, int32_t edges)
+static int32_t banner_clear_guest_path_edges(PathElement* pathElement, int32_t edges)
 {
-    if (_peepPathFindIsStaff)
-        return edges;
     TileElement* bannerElement = get_banner_on_path(reinterpret_cast<TileElement*>(pathElement));
     if (bannerElement != nullptr)
     {
@@ -94,6 +96,13 @@ static int32_t banner_clear_path_edges(PathElement* pathElement, int32_t edges)
     return edges;
 }
 
+static int32_t banner_clear_path_edges(PathElement* pathElement, int32_t edges)
+{
+    if (_peepPathFindIsStaff)
+        return edges;
+    return banner_clear_guest_path_edges(pathElement, edges);
+}
+
 /**
  * Gets the connected edges of a path that are permitted (i.e. no 'no entry' signs)
  */
@@ -102,6 +111,14 @@ static int32_t path_get_permitted_edges(PathElement* pathElement)
     return banner_clear_path_edges(pathElement, pathElement->GetEdgesAndCorners()) & 0x0F;
 }
 
+/**
+ * Gets the connected edges of a path that guests may walk through, regardless of who is pathfinding.
+ */
+uint8_t path_get_guest_permitted_edges(PathElement* pathElement)
+{
+    return banner_clear_guest_path_edges(pathElement, pathElement->GetEdgesAndCorners()) & 0x0F;
+}
+
 /**
  *
  *  rct2: 0x0069524E
@@ -522,6 +539,64 @@ static int32_t CalculateHeuristicPathingScore(TileCoordsXYZ loc1, TileCoordsXYZ
     return xDelta + yDelta + zDelta;
 }
 
+/**
+ * Walks the tiles of a footpath graph segment with the same results as
+ * stepping through them one by one in peep_pathfind_heuristic_search.
+ * Returns false if the current search path ends on one of the tiles.
+ */
+static bool peep_pathfind_walk_segment(
+    const FootpathGraphSegment& segment, uint8_t* counter, uint16_t* endScore, uint8_t* endJunctions,
+    TileCoordsXYZ junctionList[16], uint8_t directionList[16], TileCoordsXYZ* endXYZ, uint8_t* endSteps)
+{
+    int32_t numTiles = (int32_t)segment.Tiles.size();
+    const TileCoordsXYZ& start = _peepPathFindHistory[0].location;
+
+    /* Nothing along the segment can end the search path, skip over it. */
+    if (*counter + numTiles < 200 && _peepPathFindTilesChecked - numTiles > 0 && !segment.MayContain(start)
+        && !segment.MayContain(gPeepPathFindGoalPosition))
+    {
+        *counter += numTiles;
+        _peepPathFindTilesChecked -= numTiles;
+        return true;
+    }
+
+    for (const auto& tile : segment.Tiles)
+    {
+        ++*counter;
+        _peepPathFindTilesChecked--;
+
+        if (start.x == tile.x && start.y == tile.y && start.z == tile.entryZ)
+            return false;
+
+        TileCoordsXYZ loc = { tile.x, tile.y, tile.baseZ };
+        uint16_t new_score = CalculateHeuristicPathingScore(loc, gPeepPathFindGoalPosition);
+        if (new_score == 0 || *counter >= 200 || _peepPathFindTilesChecked <= 0)
+        {
+            /* Either the goal or a search limit has been reached. */
+            if (new_score < *endScore || (new_score == *endScore && *counter < *endSteps))
+            {
+                // Update the search results
+                *endScore = new_score;
+                *endSteps = *counter;
+                // Update the end x,y,z
+                *endXYZ = loc;
+                // Update the telemetry
+                *endJunctions = _peepPathFindMaxJunctions - _peepPathFindNumJunctions;
+                for (uint8_t junctInd = 0; junctInd < *endJunctions; junctInd++)
+                {
+                    uint8_t histIdx = _peepPathFindMaxJunctions - junctInd;
+                    junctionList[junctInd].x = _peepPathFindHistory[histIdx].location.x;
+                    junctionList[junctInd].y = _peepPathFindHistory[histIdx].location.y;
+                    junctionList[junctInd].z = _peepPathFindHistory[histIdx].location.z;
+                    directionList[junctInd] = _peepPathFindHistory[histIdx].direction;
+                }
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
 /**
  * Searches for the tile with the best heuristic score within the search limits
  * starting from the given tile x,y,z and going in the given direction test_edge.
@@ -599,18 +674,34 @@ static int32_t CalculateHeuristicPathingScore(TileCoordsXYZ loc1, TileCoordsXYZ
  *  rct2: 0x0069A997
  */
 static void peep_pathfind_heuristic_search(
-    TileCoordsXYZ loc, Peep* peep, TileElement* currentTileElement, bool inPatrolArea, uint8_t counter, uint16_t* endScore,
+    TileCoordsXYZ loc, Peep* peep, bool currentElementIsWide, bool inPatrolArea, uint8_t counter, uint16_t* endScore,
     Direction test_edge, uint8_t* endJunctions, TileCoordsXYZ junctionList[16], uint8_t directionList[16],
     TileCoordsXYZ* endXYZ, uint8_t* endSteps)
 {
     uint8_t searchResult = PATH_SEARCH_FAILED;
 
-    bool currentElementIsWide
-        = (currentTileElement->AsPath()->IsWide()
-           && !staff_can_ignore_wide_flag(peep, loc.x * 32, loc.y * 32, loc.z, currentTileElement));
-
     loc += TileDirectionDelta[test_edge];
 
+    /* Corridors of thin paths without junctions are walked in one go
+     * using the footpath graph, the search then continues from the tile
+     * after the corridor. */
+    if (_peepPathFindUseGraph)
+    {
+        const auto& segment = gFootpathGraph.GetSegment(loc, test_edge);
+        if (!segment.IsEmpty())
+        {
+            if (peep_pathfind_walk_segment(
+                    segment, &counter, endScore, endJunctions, junctionList, directionList, endXYZ, endSteps))
+            {
+                const auto& lastTile = segment.Tiles.back();
+                peep_pathfind_heuristic_search(
+                    { lastTile.x, lastTile.y, segment.ExitHeight }, peep, false, inPatrolArea, counter, endScore,
+                    segment.ExitDirection, endJunctions, junctionList, directionList, endXYZ, endSteps);
+            }
+            return;
+        }
+    }
+
     ++counter;
     _peepPathFindTilesChecked--;
 
@@ -1121,8 +1212,11 @@ static void peep_pathfind_heuristic_search(
                 _peepPathFindHistory[_peepPathFindNumJunctions + 1].direction = next_test_edge;
             }
 
+            bool isWide
+                = (tileElement->AsPath()->IsWide()
+                   && !staff_can_ignore_wide_flag(peep, loc.x * 32, loc.y * 32, height, tileElement));
             peep_pathfind_heuristic_search(
-                { loc.x, loc.y, height }, peep, tileElement, nextInPatrolArea, counter, endScore, next_test_edge, endJunctions,
+                { loc.x, loc.y, height }, peep, isWide, nextInPatrolArea, counter, endScore, next_test_edge, endJunctions,
                 junctionList, directionList, endXYZ, endSteps);
             _peepPathFindNumJunctions = savedNumJunctions;
 
@@ -1176,6 +1270,9 @@ Direction peep_pathfind_choose_direction(TileCoordsXYZ loc, Peep* peep)
     int32_t maxTilesChecked = (peep->type == PEEP_TYPE_STAFF) ? 50000 : 15000;
     // Used to allow walking through no entry banners
     _peepPathFindIsStaff = (peep->type == PEEP_TYPE_STAFF);
+    // Mechanics check their patrol area on every tile, so they cannot skip along footpath graph segments
+    _peepPathFindUseGraph = gFootpathGraph.IsEnabled()
+        && !(peep->type == PEEP_TYPE_STAFF && peep->staff_type == STAFF_TYPE_MECHANIC);
 
     TileCoordsXYZ goal = gPeepPathFindGoalPosition;
 
@@ -1240,6 +1337,19 @@ Direction peep_pathfind_choose_direction(TileCoordsXYZ loc, Peep* peep)
         return INVALID_DIRECTION;
 
     permitted_edges &= 0xF;
+
+    // Guests share a breadth first search per goal instead of searching on their own. The fields can pick a different,
+    // equally short, walk than the heuristic search, so they are never used when the result must match other clients.
+    if (peep->type == PEEP_TYPE_GUEST && gGuestDistanceFields.IsEnabled() && network_get_mode() == NETWORK_MODE_NONE)
+    {
+        Direction fieldDirection = gGuestDistanceFields.GetDirection(
+            loc, goal, gPeepPathFindQueueRideIndex, gPeepPathFindIgnoreForeignQueues);
+        if (fieldDirection != INVALID_DIRECTION && (permitted_edges & (1 << fieldDirection)))
+        {
+            return fieldDirection;
+        }
+    }
+
     uint8_t edges = permitted_edges;
     if (isThin && peep->pathfind_goal.x == goal.x && peep->pathfind_goal.y == goal.y && peep->pathfind_goal.z == goal.z)
     {
@@ -1420,9 +1530,12 @@ Direction peep_pathfind_choose_direction(TileCoordsXYZ loc, Peep* peep)
             }
 #endif // defined(DEBUG_LEVEL_2) && DEBUG_LEVEL_2
 
+            bool isWide
+                = (first_tile_element->AsPath()->IsWide()
+                   && !staff_can_ignore_wide_flag(peep, loc.x * 32, loc.y * 32, height, first_tile_element));
             peep_pathfind_heuristic_search(
-                { loc.x, loc.y, height }, peep, first_tile_element, inPatrolArea, 0, &score, test_edge, &endJunctions,
-                endJunctionList, endDirectionList, &endXYZ, &endSteps);
+                { loc.x, loc.y, height }, peep, isWide, inPatrolArea, 0, &score, test_edge, &endJunctions, endJunctionList,
+                endDirectionList, &endXYZ, &endSteps);
 
 #if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
             if (gPathFindDebug)
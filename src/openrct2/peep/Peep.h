@@ -43,6 +43,7 @@
 #define PEEP_MAX_THIRST 255
 
 struct TileElement;
+struct PathElement;
 struct Ride;
 
 enum PeepType : uint8_t
@@ -989,6 +990,7 @@ Direction peep_pathfind_choose_direction(TileCoordsXYZ loc, Peep* peep);
 void peep_reset_pathfind_goal(Peep* peep);
 
 bool is_valid_path_z_and_direction(TileElement* tileElement, int32_t currentZ, int32_t currentDirection);
+uint8_t path_get_guest_permitted_edges(PathElement* pathElement);
 int32_t guest_path_finding(Guest* peep);
 
 #if defined(DEBUG_LEVEL_1) && DEBUG_LEVEL_1
@@ -17,6 +17,7 @@
 #    include <cstring>
 #    include <ctime>
 #    include <pwd.h>
+#    include <sys/resource.h>
 
 namespace Platform
 {
@@ -96,6 +97,21 @@ namespace Platform
         }
         return isSupported;
     }
+
+    uint64_t GetPeakMemoryUsage()
+    {
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+        {
+            return 0;
+        }
+#    if defined(__APPLE__) && defined(__MACH__)
+        // Already in bytes on macOS
+        return (uint64_t)usage.ru_maxrss;
+#    else
+        return (uint64_t)usage.ru_maxrss * 1024;
+#    endif
+    }
 } // namespace Platform
 
 #endif
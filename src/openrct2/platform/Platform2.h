@@ -46,6 +46,11 @@ namespace Platform
 #endif
 
     bool IsColourTerminalSupported();
+
+    /**
+     * Returns the largest amount of memory the process has had resident so far, in bytes.
+     */
+    uint64_t GetPeakMemoryUsage();
     bool HandleSpecialCommandLineArgument(const char* argument);
     uintptr_t StrDecompToPrecomp(utf8* input);
 } // namespace Platform
@@ -2093,6 +2093,7 @@ static void track_design_preview_restore_map(map_backup* backup)
     gMapSizeMinus2 = backup->map_size_units_minus_2;
     gMapSize = backup->map_size;
     gCurrentRotation = backup->current_rotation;
+    map_mark_all_tiles_modified();
 
     free(backup);
 }
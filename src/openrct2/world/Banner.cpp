@@ -20,6 +20,7 @@
 #include "../ride/Ride.h"
 #include "../ride/Track.h"
 #include "../windows/Intent.h"
+#include "FootpathGraph.h"
 #include "Map.h"
 #include "MapAnimation.h"
 #include "Park.h"
@@ -351,12 +352,16 @@ uint8_t BannerElement::GetAllowedEdges() const
 
 void BannerElement::SetAllowedEdges(uint8_t newEdges)
 {
+    if ((flags ^ newEdges) & 0b00001111)
+        footpath_graph_invalidate();
     flags &= ~0b00001111;
     flags |= (newEdges & 0b00001111);
 }
 
 void BannerElement::ResetAllowedEdges()
 {
+    if ((flags & 0b00001111) != 0b00001111)
+        footpath_graph_invalidate();
     flags |= 0b00001111;
 }
 
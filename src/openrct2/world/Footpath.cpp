@@ -26,6 +26,7 @@
 #include "../ride/Track.h"
 #include "../ride/TrackData.h"
 #include "../util/Util.h"
+#include "FootpathGraph.h"
 #include "Map.h"
 #include "MapAnimation.h"
 #include "Park.h"
@@ -1425,9 +1426,12 @@ bool PathElement::IsSloped() const
 
 void PathElement::SetSloped(bool isSloped)
 {
+    auto oldEntryIndex = entryIndex;
     entryIndex &= ~FOOTPATH_PROPERTIES_FLAG_IS_SLOPED;
     if (isSloped)
         entryIndex |= FOOTPATH_PROPERTIES_FLAG_IS_SLOPED;
+    if (entryIndex != oldEntryIndex)
+        footpath_graph_invalidate();
 }
 
 Direction PathElement::GetSlopeDirection() const
@@ -1437,8 +1441,11 @@ Direction PathElement::GetSlopeDirection() const
 
 void PathElement::SetSlopeDirection(Direction newSlope)
 {
+    auto oldEntryIndex = entryIndex;
     entryIndex &= ~FOOTPATH_PROPERTIES_SLOPE_DIRECTION_MASK;
     entryIndex |= static_cast<uint8_t>(newSlope) & FOOTPATH_PROPERTIES_SLOPE_DIRECTION_MASK;
+    if (entryIndex != oldEntryIndex)
+        footpath_graph_invalidate();
 }
 
 bool PathElement::IsQueue() const
@@ -1448,9 +1455,12 @@ bool PathElement::IsQueue() const
 
 void PathElement::SetIsQueue(bool isQueue)
 {
+    auto oldType = type;
     type &= ~FOOTPATH_ELEMENT_TYPE_FLAG_IS_QUEUE;
     if (isQueue)
         type |= FOOTPATH_ELEMENT_TYPE_FLAG_IS_QUEUE;
+    if (type != oldType)
+        footpath_graph_invalidate();
 }
 
 bool PathElement::HasQueueBanner() const
@@ -1661,21 +1671,34 @@ static TileElement* footpath_can_be_wide(int32_t x, int32_t y, uint8_t height)
     return nullptr;
 }
 
+/**
+ * Returns the wide flags of the paths on a tile, one bit per tile element, or UINT64_MAX if the tile has too many
+ * elements to tell.
+ */
+static uint64_t footpath_get_wide_flags(int32_t x, int32_t y)
+{
+    TileElement* tileElement = map_get_first_element_at({ x, y });
+    if (tileElement == nullptr)
+        return 0;
+    uint64_t result = 0;
+    uint32_t index = 0;
+    do
+    {
+        if (index >= 64)
+            return UINT64_MAX;
+        if (tileElement->GetType() == TILE_ELEMENT_TYPE_PATH && tileElement->AsPath()->IsWide())
+            result |= 1ULL << index;
+        index++;
+    } while (!(tileElement++)->IsLastForTile());
+    return result;
+}
+
 /**
  *
  *  rct2: 0x006A87BB
  */
-void footpath_update_path_wide_flags(int32_t x, int32_t y)
+static void footpath_update_path_wide_flags_on_tile(int32_t x, int32_t y)
 {
-    if (x < 0x20)
-        return;
-    if (y < 0x20)
-        return;
-    if (x > 0x1FDF)
-        return;
-    if (y > 0x1FDF)
-        return;
-
     footpath_clear_wide(x, y);
     /* Rather than clearing the wide flag of the following tiles and
      * checking the state of them later, leave them intact and assume
@@ -1869,6 +1892,27 @@ void footpath_update_path_wide_flags(int32_t x, int32_t y)
     } while (!(tileElement++)->IsLastForTile());
 }
 
+void footpath_update_path_wide_flags(int32_t x, int32_t y)
+{
+    if (x < 0x20)
+        return;
+    if (y < 0x20)
+        return;
+    if (x > 0x1FDF)
+        return;
+    if (y > 0x1FDF)
+        return;
+
+    // The flags are cleared and then worked out again, the footpath graph only has to be rebuilt if any end up different.
+    uint64_t oldWideFlags = footpath_get_wide_flags(x, y);
+    footpath_update_path_wide_flags_on_tile(x, y);
+    uint64_t newWideFlags = footpath_get_wide_flags(x, y);
+    if (oldWideFlags == UINT64_MAX || newWideFlags != oldWideFlags)
+    {
+        footpath_graph_invalidate();
+    }
+}
+
 bool footpath_is_blocked_by_vehicle(const TileCoordsXYZ& position)
 {
     auto pathElement = map_get_path_element_at(position);
@@ -2214,6 +2258,8 @@ ride_id_t PathElement::GetRideIndex() const
 
 void PathElement::SetRideIndex(ride_id_t newRideIndex)
 {
+    if (rideIndex != newRideIndex)
+        footpath_graph_invalidate();
     rideIndex = newRideIndex;
 }
 
@@ -2234,8 +2280,11 @@ uint8_t PathElement::GetEdges() const
 
 void PathElement::SetEdges(uint8_t newEdges)
 {
+    auto oldEdges = edges;
     edges &= ~FOOTPATH_PROPERTIES_EDGES_EDGES_MASK;
     edges |= (newEdges & FOOTPATH_PROPERTIES_EDGES_EDGES_MASK);
+    if (edges != oldEdges)
+        footpath_graph_invalidate();
 }
 
 uint8_t PathElement::GetCorners() const
@@ -2256,6 +2305,8 @@ uint8_t PathElement::GetEdgesAndCorners() const
 
 void PathElement::SetEdgesAndCorners(uint8_t newEdgesAndCorners)
 {
+    if ((edges ^ newEdgesAndCorners) & FOOTPATH_PROPERTIES_EDGES_EDGES_MASK)
+        footpath_graph_invalidate();
     edges = newEdgesAndCorners;
 }
 
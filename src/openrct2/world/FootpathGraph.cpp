@@ -0,0 +1,172 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "FootpathGraph.h"
+
+#include "../peep/Peep.h"
+#include "../util/Util.h"
+#include "Footpath.h"
+#include "Map.h"
+
+#include <algorithm>
+#include <limits>
+
+FootpathGraph gFootpathGraph;
+
+void footpath_graph_invalidate()
+{
+    gFootpathGraph.Invalidate();
+}
+
+static bool IsLocationInTechnicalMap(const TileCoordsXYZ& loc)
+{
+    return loc.x >= 0 && loc.y >= 0 && loc.x < MAXIMUM_MAP_SIZE_TECHNICAL && loc.y < MAXIMUM_MAP_SIZE_TECHNICAL;
+}
+
+static uint32_t GetSegmentKey(const TileCoordsXYZ& loc, Direction direction)
+{
+    return ((uint32_t)(uint8_t)loc.x << 18) | ((uint32_t)(uint8_t)loc.y << 10) | ((uint32_t)(uint8_t)loc.z << 2)
+        | (direction & 3);
+}
+
+/**
+ * Returns the path on the tile at loc if walking onto it at height loc.z in the given direction is guaranteed to
+ * continue in exactly one other direction, and the pathfinder would not look at any other element on the way.
+ */
+static PathElement* get_corridor_path(const TileCoordsXYZ& loc, Direction direction)
+{
+    TileElement* firstElement = map_get_first_element_at(loc.ToCoordsXY());
+    if (firstElement == nullptr)
+        return nullptr;
+
+    // The pathfinder checks every element on the tile, so there must be exactly one path it can walk onto.
+    TileElement* pathElement = nullptr;
+    TileElement* tileElement = firstElement;
+    do
+    {
+        if (tileElement->GetType() == TILE_ELEMENT_TYPE_BANNER)
+            return nullptr;
+        if (tileElement->IsGhost() || tileElement->GetType() != TILE_ELEMENT_TYPE_PATH)
+            continue;
+        if (!is_valid_path_z_and_direction(tileElement, loc.z, direction))
+            continue;
+        if (pathElement != nullptr)
+            return nullptr;
+        pathElement = tileElement;
+    } while (!(tileElement++)->IsLastForTile());
+
+    if (pathElement == nullptr)
+        return nullptr;
+
+    // Elements after the path are checked at the path's base height, so nothing may match at either height.
+    uint8_t baseZ = pathElement->base_height;
+    tileElement = firstElement;
+    do
+    {
+        if (tileElement->IsGhost() || tileElement == pathElement)
+            continue;
+        switch (tileElement->GetType())
+        {
+            case TILE_ELEMENT_TYPE_TRACK:
+            case TILE_ELEMENT_TYPE_ENTRANCE:
+                if (tileElement->base_height == loc.z || tileElement->base_height == baseZ)
+                    return nullptr;
+                break;
+            case TILE_ELEMENT_TYPE_PATH:
+                if (is_valid_path_z_and_direction(tileElement, baseZ, direction))
+                    return nullptr;
+                break;
+        }
+    } while (!(tileElement++)->IsLastForTile());
+
+    auto path = pathElement->AsPath();
+    if (path->IsWide() || path->IsQueue())
+        return nullptr;
+
+    uint8_t edges = path->GetEdges();
+    if (bitcount(edges) != 2 || !(edges & (1 << direction_reverse(direction))))
+        return nullptr;
+
+    return path;
+}
+
+FootpathGraphSegment FootpathGraph::BuildSegment(TileCoordsXYZ loc, Direction direction)
+{
+    FootpathGraphSegment segment;
+    while (segment.Tiles.size() < MaxSegmentLength && IsLocationInTechnicalMap(loc))
+    {
+        PathElement* path = get_corridor_path(loc, direction);
+        if (path == nullptr)
+            break;
+
+        FootpathGraphTile tile;
+        tile.x = (uint8_t)loc.x;
+        tile.y = (uint8_t)loc.y;
+        tile.entryZ = (uint8_t)loc.z;
+        tile.baseZ = path->base_height;
+        segment.Tiles.push_back(tile);
+
+        Direction exitDirection = bitscanforward(path->GetEdges() & ~(1 << direction_reverse(direction)));
+        uint8_t exitHeight = path->base_height;
+        if (path->IsSloped() && path->GetSlopeDirection() == exitDirection)
+        {
+            exitHeight += 2;
+        }
+        segment.ExitDirection = exitDirection;
+        segment.ExitHeight = exitHeight;
+
+        loc = { loc.x + TileDirectionDelta[exitDirection].x, loc.y + TileDirectionDelta[exitDirection].y, exitHeight };
+        direction = exitDirection;
+    }
+
+    if (!segment.IsEmpty())
+    {
+        segment.Min = { std::numeric_limits<int32_t>::max(), std::numeric_limits<int32_t>::max(),
+                        std::numeric_limits<int32_t>::max() };
+        segment.Max = { std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::min(),
+                        std::numeric_limits<int32_t>::min() };
+        for (const auto& tile : segment.Tiles)
+        {
+            segment.Min.x = std::min<int32_t>(segment.Min.x, tile.x);
+            segment.Min.y = std::min<int32_t>(segment.Min.y, tile.y);
+            segment.Min.z = std::min<int32_t>(segment.Min.z, std::min(tile.entryZ, tile.baseZ));
+            segment.Max.x = std::max<int32_t>(segment.Max.x, tile.x);
+            segment.Max.y = std::max<int32_t>(segment.Max.y, tile.y);
+            segment.Max.z = std::max<int32_t>(segment.Max.z, std::max(tile.entryZ, tile.baseZ));
+        }
+    }
+    return segment;
+}
+
+void FootpathGraph::SetEnabled(bool enabled)
+{
+    _enabled = enabled;
+    Invalidate();
+}
+
+const FootpathGraphSegment& FootpathGraph::GetSegment(const TileCoordsXYZ& loc, Direction direction)
+{
+    static const FootpathGraphSegment EmptySegment;
+    if (!IsLocationInTechnicalMap(loc))
+        return EmptySegment;
+
+    if (_builtGeneration != _generation)
+    {
+        _segments.clear();
+        _builtGeneration = _generation;
+    }
+
+    auto key = GetSegmentKey(loc, direction);
+    auto it = _segments.find(key);
+    if (it == _segments.end())
+    {
+        it = _segments.emplace(key, BuildSegment(loc, direction)).first;
+    }
+    return it->second;
+}
@@ -0,0 +1,111 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "Location.hpp"
+
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+struct FootpathGraphTile
+{
+    uint8_t x;
+    uint8_t y;
+    // The height the tile is entered at, which is what the search loop check compares against.
+    uint8_t entryZ;
+    uint8_t baseZ;
+};
+
+/**
+ * A run of path tiles that can only be walked straight through: every tile holds a single thin, non-queue path with
+ * exactly two edges and nothing else the pathfinder looks at. Leaving the last tile by ExitDirection at ExitHeight
+ * enters the first tile that is not part of the segment.
+ */
+struct FootpathGraphSegment
+{
+    std::vector<FootpathGraphTile> Tiles;
+    Direction ExitDirection = INVALID_DIRECTION;
+    uint8_t ExitHeight = 0;
+    TileCoordsXYZ Min;
+    TileCoordsXYZ Max;
+
+    bool IsEmpty() const
+    {
+        return Tiles.empty();
+    }
+
+    /**
+     * Whether the given location may be one of the segment's tiles, either at its entry height or its base height.
+     */
+    bool MayContain(const TileCoordsXYZ& loc) const
+    {
+        return loc.x >= Min.x && loc.x <= Max.x && loc.y >= Min.y && loc.y <= Max.y && loc.z >= Min.z && loc.z <= Max.z;
+    }
+};
+
+/**
+ * Caches the corridors of the footpath network so the peep pathfinder can walk them without examining every tile
+ * element on the way. The whole graph is dropped when anything that affects the pathfinder changes on the map, and
+ * segments are rebuilt on demand as they are queried.
+ */
+class FootpathGraph
+{
+public:
+    static constexpr size_t MaxSegmentLength = 64;
+
+    bool IsEnabled() const
+    {
+        return _enabled;
+    }
+
+    void SetEnabled(bool enabled);
+
+    /**
+     * Marks every cached segment as stale, they are discarded on the next query.
+     */
+    void Invalidate()
+    {
+        _generation++;
+    }
+
+    /**
+     * Returns a number that changes whenever anything that affects pathfinding changes on the map, for caches built
+     * on top of the footpath network.
+     */
+    uint32_t GetGeneration() const
+    {
+        return _generation;
+    }
+
+    /**
+     * Returns the segment that starts at the tile entered by walking in the given direction at height loc.z into
+     * loc.x, loc.y. The returned segment is empty if that tile is not a corridor tile.
+     */
+    const FootpathGraphSegment& GetSegment(const TileCoordsXYZ& loc, Direction direction);
+
+    size_t GetNumSegments() const
+    {
+        return _segments.size();
+    }
+
+private:
+    static FootpathGraphSegment BuildSegment(TileCoordsXYZ loc, Direction direction);
+
+    bool _enabled = true;
+    uint32_t _generation = 0;
+    uint32_t _builtGeneration = std::numeric_limits<uint32_t>::max();
+    std::unordered_map<uint32_t, FootpathGraphSegment> _segments;
+};
+
+extern FootpathGraph gFootpathGraph;
+
+void footpath_graph_invalidate();
@@ -0,0 +1,160 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "LitterIndex.h"
+
+#include "Sprite.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+LitterIndex gLitterIndex;
+
+static uint16_t GetBlockIndex(int32_t x, int32_t y)
+{
+    if (x < 0 || y < 0 || x >= 0x2000 || y >= 0x2000)
+        return 0xFFFF;
+    return (uint16_t)((x / LitterIndex::BlockSize) * LitterIndex::NumBlocksPerAxis + (y / LitterIndex::BlockSize));
+}
+
+void LitterIndex::Invalidate()
+{
+    _isValid = false;
+}
+
+void LitterIndex::Validate()
+{
+    if (_isValid)
+        return;
+
+    _blocks.assign(NumBlocksPerAxis * NumBlocksPerAxis, {});
+    _spriteBlocks.assign(MAX_SPRITES, NoBlock);
+    _sequences.assign(MAX_SPRITES, 0);
+
+    // New litter is always added to the head of the list, so later litter gets a higher sequence number.
+    std::vector<uint16_t> litterList;
+    for (uint16_t spriteIndex = gSpriteListHead[SPRITE_LIST_LITTER]; spriteIndex != SPRITE_INDEX_NULL;
+         spriteIndex = get_sprite(spriteIndex)->generic.next)
+    {
+        litterList.push_back(spriteIndex);
+    }
+    _nextSequence = (uint32_t)litterList.size() + 1;
+    for (size_t i = 0; i < litterList.size(); i++)
+    {
+        auto litter = &get_sprite(litterList[i])->litter;
+        _sequences[litterList[i]] = (uint32_t)(litterList.size() - i);
+        Insert(litterList[i], litter->x, litter->y);
+    }
+    _isValid = true;
+}
+
+void LitterIndex::Insert(uint16_t spriteIndex, int32_t x, int32_t y)
+{
+    auto blockIndex = GetBlockIndex(x, y);
+    _spriteBlocks[spriteIndex] = blockIndex;
+    if (blockIndex != NoBlock)
+    {
+        _blocks[blockIndex].push_back(spriteIndex);
+    }
+}
+
+void LitterIndex::Erase(uint16_t spriteIndex)
+{
+    auto blockIndex = _spriteBlocks[spriteIndex];
+    if (blockIndex != NoBlock)
+    {
+        auto& block = _blocks[blockIndex];
+        auto it = std::find(block.begin(), block.end(), spriteIndex);
+        if (it != block.end())
+        {
+            *it = block.back();
+            block.pop_back();
+        }
+    }
+    _spriteBlocks[spriteIndex] = NoBlock;
+}
+
+void LitterIndex::Move(const rct_litter* litter)
+{
+    if (!_isValid)
+        return;
+
+    uint16_t spriteIndex = litter->sprite_index;
+    if (_sequences[spriteIndex] == 0)
+    {
+        _sequences[spriteIndex] = _nextSequence++;
+    }
+    else
+    {
+        Erase(spriteIndex);
+    }
+    Insert(spriteIndex, litter->x, litter->y);
+}
+
+void LitterIndex::Remove(const rct_litter* litter)
+{
+    if (!_isValid)
+        return;
+
+    Erase(litter->sprite_index);
+    _sequences[litter->sprite_index] = 0;
+}
+
+template<typename TFunc> void LitterIndex::ForEachInBox(const CoordsXY& min, const CoordsXY& max, TFunc func)
+{
+    Validate();
+
+    int32_t minBlockX = std::max(min.x, 0) / BlockSize;
+    int32_t minBlockY = std::max(min.y, 0) / BlockSize;
+    int32_t maxBlockX = std::min(max.x, 0x1FFF) / BlockSize;
+    int32_t maxBlockY = std::min(max.y, 0x1FFF) / BlockSize;
+    for (int32_t blockX = minBlockX; blockX <= maxBlockX; blockX++)
+    {
+        for (int32_t blockY = minBlockY; blockY <= maxBlockY; blockY++)
+        {
+            for (auto spriteIndex : _blocks[blockX * NumBlocksPerAxis + blockY])
+            {
+                func(&get_sprite(spriteIndex)->litter);
+            }
+        }
+    }
+}
+
+rct_litter* LitterIndex::FindNearest(const CoordsXYZ& loc, int32_t maxDistance)
+{
+    rct_litter* nearestLitter = nullptr;
+    int32_t nearestDistance = maxDistance + 1;
+    uint32_t nearestSequence = 0;
+    ForEachInBox(
+        { loc.x - maxDistance, loc.y - maxDistance }, { loc.x + maxDistance, loc.y + maxDistance },
+        [&](rct_litter* litter) {
+            int32_t distance = abs(litter->x - loc.x) + abs(litter->y - loc.y) + abs(litter->z - loc.z) * 4;
+            uint32_t sequence = _sequences[litter->sprite_index];
+            if (distance < nearestDistance
+                || (distance == nearestDistance && nearestLitter != nullptr && sequence > nearestSequence))
+            {
+                nearestLitter = litter;
+                nearestDistance = distance;
+                nearestSequence = sequence;
+            }
+        });
+    return nearestLitter;
+}
+
+int32_t LitterIndex::CountInRange(const CoordsXY& centre, int32_t range)
+{
+    int32_t count = 0;
+    ForEachInBox({ centre.x - range, centre.y - range }, { centre.x + range, centre.y + range }, [&](rct_litter* litter) {
+        if (std::max(abs(litter->x - centre.x), abs(litter->y - centre.y)) <= range)
+        {
+            count++;
+        }
+    });
+    return count;
+}
@@ -0,0 +1,68 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "Location.hpp"
+
+#include <vector>
+
+struct rct_litter;
+
+/**
+ * Buckets litter by blocks of tiles so searches around a location only look at the litter nearby instead of the whole
+ * litter list. The index is not saved, it is rebuilt from the sprite list the first time it is used after a load.
+ */
+class LitterIndex
+{
+public:
+    static constexpr int32_t BlockSize = 4 * COORDS_XY_STEP;
+    static constexpr int32_t NumBlocksPerAxis = 0x2000 / BlockSize;
+
+    /**
+     * Discards the index, it is rebuilt from the litter sprite list on the next query.
+     */
+    void Invalidate();
+
+    /**
+     * Adds the litter to the index or moves it to the block of its current position.
+     */
+    void Move(const rct_litter* litter);
+    void Remove(const rct_litter* litter);
+
+    /**
+     * Returns the litter closest to loc by |dx| + |dy| + 4|dz|, or nullptr if none is within maxDistance. When several
+     * are equally close, the one nearest the head of the litter sprite list is returned.
+     */
+    rct_litter* FindNearest(const CoordsXYZ& loc, int32_t maxDistance);
+
+    /**
+     * Returns the number of litter sprites no further than range from centre along either axis.
+     */
+    int32_t CountInRange(const CoordsXY& centre, int32_t range);
+
+private:
+    static constexpr uint16_t NoBlock = 0xFFFF;
+
+    void Validate();
+    void Insert(uint16_t spriteIndex, int32_t x, int32_t y);
+    void Erase(uint16_t spriteIndex);
+
+    template<typename TFunc> void ForEachInBox(const CoordsXY& min, const CoordsXY& max, TFunc func);
+
+    bool _isValid = false;
+    uint32_t _nextSequence = 0;
+    std::vector<std::vector<uint16_t>> _blocks;
+    // Per sprite index, the block the litter is in and the order it was added to the litter list in.
+    std::vector<uint16_t> _spriteBlocks;
+    std::vector<uint32_t> _sequences;
+};
+
+extern LitterIndex gLitterIndex;
@@ -46,6 +46,7 @@
 #include "Banner.h"
 #include "Climate.h"
 #include "Footpath.h"
+#include "FootpathGraph.h"
 #include "LargeScenery.h"
 #include "MapAnimation.h"
 #include "Park.h"
@@ -107,7 +108,45 @@ uint16_t gLandRemainingConstructionSales;
 
 bool gMapLandRightsUpdateSuccess;
 
+// Modification generations used to tell whether cached paint output of a tile is still valid. The generation of a
+// tile is the sum of both counters, which only ever increase.
+static uint32_t _mapGeneration;
+static uint32_t _tileGenerations[MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL];
+
 static void clear_elements_at(const CoordsXY& loc);
+
+uint32_t map_get_tile_generation(const TileCoordsXY& tilePos)
+{
+    if (tilePos.x < 0 || tilePos.y < 0 || tilePos.x >= MAXIMUM_MAP_SIZE_TECHNICAL || tilePos.y >= MAXIMUM_MAP_SIZE_TECHNICAL)
+    {
+        return _mapGeneration;
+    }
+    return _mapGeneration + _tileGenerations[tilePos.y * MAXIMUM_MAP_SIZE_TECHNICAL + tilePos.x];
+}
+
+void map_mark_all_tiles_modified()
+{
+    _mapGeneration++;
+}
+
+/**
+ * Marks the tiles in the given range as modified, including their neighbours as tiles paint parts of their
+ * neighbours, such as surface edges.
+ */
+static void map_mark_tiles_modified(int32_t x0, int32_t y0, int32_t x1, int32_t y1)
+{
+    x0 = std::max(x0 - 1, 0);
+    y0 = std::max(y0 - 1, 0);
+    x1 = std::min(x1 + 1, MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+    y1 = std::min(y1 + 1, MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+    for (int32_t y = y0; y <= y1; y++)
+    {
+        for (int32_t x = x0; x <= x1; x++)
+        {
+            _tileGenerations[y * MAXIMUM_MAP_SIZE_TECHNICAL + x]++;
+        }
+    }
+}
 static ScreenCoordsXY translate_3d_to_2d(int32_t rotation, const CoordsXY& pos);
 
 void tile_element_iterator_begin(tile_element_iterator* it)
@@ -374,6 +413,9 @@ void map_update_tile_pointers()
 {
     int32_t i, x, y;
 
+    map_mark_all_tiles_modified();
+    footpath_graph_invalidate();
+
     for (i = 0; i < MAX_TILE_TILE_ELEMENT_POINTERS; i++)
     {
         gTileElementTilePointers[i] = TILE_UNDEFINED_TILE_ELEMENT;
@@ -917,6 +959,8 @@ bool map_is_location_at_edge(const CoordsXY& loc)
  */
 void tile_element_remove(TileElement* tileElement)
 {
+    footpath_graph_invalidate();
+
     // Replace Nth element by (N+1)th element.
     // This loop will make tileElement point to the old last element position,
     // after copy it to it's new position
@@ -1138,11 +1182,14 @@ TileElement* tile_element_insert(const TileCoordsXYZ& loc, int32_t occupiedQuadr
         return nullptr;
     }
 
+    footpath_graph_invalidate();
+
     newTileElement = gNextFreeTileElement;
     originalTileElement = gTileElementTilePointers[loc.y * MAXIMUM_MAP_SIZE_TECHNICAL + loc.x];
 
     // Set tile index pointer to point to new element block
     gTileElementTilePointers[loc.y * MAXIMUM_MAP_SIZE_TECHNICAL + loc.x] = newTileElement;
+    map_mark_tiles_modified(loc.x, loc.y, loc.x, loc.y);
 
     // Copy all elements that are below the insert height
     while (loc.z >= originalTileElement->base_height)
@@ -1949,7 +1996,9 @@ ScreenCoordsXY translate_3d_to_2d_with_z(int32_t rotation, const CoordsXYZ& pos)
 
 static void map_invalidate_tile_under_zoom(int32_t x, int32_t y, int32_t z0, int32_t z1, int32_t maxZoom)
 {
-    if (gOpenRCT2Headless)
+    map_mark_tiles_modified(x / 32, y / 32, x / 32, y / 32);
+
+    if (gOpenRCT2Headless || gInTurboUpdate)
         return;
 
     int32_t x1, y1, x2, y2;
@@ -2018,6 +2067,8 @@ void map_invalidate_region(const CoordsXY& mins, const CoordsXY& maxs)
 {
     int32_t x0, y0, x1, y1, left, right, top, bottom;
 
+    map_mark_tiles_modified(mins.x / 32, mins.y / 32, maxs.x / 32, maxs.y / 32);
+
     x0 = mins.x + 16;
     y0 = mins.y + 16;
 
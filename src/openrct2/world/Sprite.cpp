@@ -20,6 +20,7 @@
 #include "../localisation/Localisation.h"
 #include "../scenario/Scenario.h"
 #include "Fountain.h"
+#include "LitterIndex.h"
 
 #include <algorithm>
 #include <cmath>
@@ -100,7 +101,7 @@ uint16_t sprite_get_first_in_quadrant(int32_t x, int32_t y)
 
 static void invalidate_sprite_max_zoom(rct_sprite* sprite, int32_t maxZoom)
 {
-    if (sprite->generic.sprite_left == LOCATION_NULL)
+    if (sprite->generic.sprite_left == LOCATION_NULL || gInTurboUpdate)
         return;
 
     for (int32_t i = 0; i < MAX_VIEWPORT_COUNT; i++)
@@ -209,6 +210,7 @@ void reset_sprite_spatial_index()
             spr->generic.next_in_quadrant = nextSpriteId;
         }
     }
+    gLitterIndex.Invalidate();
 }
 
 static size_t GetSpatialIndexOffset(int32_t x, int32_t y)
@@ -670,6 +672,11 @@ void sprite_move(int16_t x, int16_t y, int16_t z, rct_sprite* sprite)
     {
         sprite_set_coordinates(x, y, z, sprite);
     }
+
+    if (sprite->generic.linked_list_index == SPRITE_LIST_LITTER)
+    {
+        gLitterIndex.Move(&sprite->litter);
+    }
 }
 
 void sprite_set_coordinates(int16_t x, int16_t y, int16_t z, rct_sprite* sprite)
@@ -697,6 +704,10 @@ void sprite_remove(rct_sprite* sprite)
     {
         peep->SetName({});
     }
+    if (sprite->generic.linked_list_index == SPRITE_LIST_LITTER)
+    {
+        gLitterIndex.Remove(&sprite->litter);
+    }
 
     move_sprite_to_list(sprite, SPRITE_LIST_FREE);
     sprite->generic.sprite_identifier = SPRITE_IDENTIFIER_NULL;
@@ -14,6 +14,7 @@
 #include "../localisation/Localisation.h"
 #include "../ride/Track.h"
 #include "Banner.h"
+#include "FootpathGraph.h"
 #include "LargeScenery.h"
 #include "Scenery.h"
 
@@ -64,6 +65,10 @@ bool TileElementBase::IsGhost() const
 
 void TileElementBase::SetGhost(bool isGhost)
 {
+    if (isGhost != IsGhost())
+    {
+        footpath_graph_invalidate();
+    }
     if (isGhost)
     {
         this->flags |= TILE_ELEMENT_FLAG_GHOST;
@@ -0,0 +1,144 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <memory>
+#include <openrct2/paint/Paint.h>
+#include <openrct2/util/Util.h>
+#include <random>
+#include <vector>
+
+using CheckBoundingBoxesFunction = decltype(paint_check_bounding_boxes_fn);
+
+struct BoundsArrays
+{
+    std::vector<uint16_t> X, Y, Z, XEnd, YEnd, ZEnd;
+
+    PaintBoundsView GetView() const
+    {
+        return { X.data(), Y.data(), Z.data(), XEnd.data(), YEnd.data(), ZEnd.data() };
+    }
+};
+
+// Small coordinates make equal edges common, offsetting them exercises the unsigned comparisons.
+static paint_struct_bound_box GenerateBounds(std::mt19937& rng, uint16_t offset)
+{
+    paint_struct_bound_box bounds;
+    bounds.x = offset + rng() % 16;
+    bounds.y = offset + rng() % 16;
+    bounds.z = offset + rng() % 16;
+    bounds.x_end = bounds.x + rng() % 8;
+    bounds.y_end = bounds.y + rng() % 8;
+    bounds.z_end = bounds.z + rng() % 8;
+    return bounds;
+}
+
+static std::vector<CheckBoundingBoxesFunction> GetAvailableFunctions()
+{
+    std::vector<CheckBoundingBoxesFunction> functions = { paint_check_bounding_boxes_scalar };
+    if (sse41_available())
+    {
+        functions.push_back(paint_check_bounding_boxes_sse4_1);
+    }
+    if (avx2_available())
+    {
+        functions.push_back(paint_check_bounding_boxes_avx2);
+    }
+    return functions;
+}
+
+TEST(PaintSortTest, CheckBoundingBoxesMatchesScalar)
+{
+    std::mt19937 rng(42);
+    for (uint16_t offset : { 0, 0x7FF0, 0xFFE0 })
+    {
+        BoundsArrays candidates;
+        for (int32_t i = 0; i < 101; i++)
+        {
+            auto bounds = GenerateBounds(rng, offset);
+            candidates.X.push_back(bounds.x);
+            candidates.Y.push_back(bounds.y);
+            candidates.Z.push_back(bounds.z);
+            candidates.XEnd.push_back(bounds.x_end);
+            candidates.YEnd.push_back(bounds.y_end);
+            candidates.ZEnd.push_back(bounds.z_end);
+        }
+        auto view = candidates.GetView();
+        for (uint8_t rotation = 0; rotation < 4; rotation++)
+        {
+            for (int32_t n = 0; n < 32; n++)
+            {
+                auto initialBBox = GenerateBounds(rng, offset);
+                size_t begin = rng() % 8;
+                size_t end = begin + rng() % (candidates.X.size() - begin);
+
+                std::vector<uint8_t> expected(end - begin);
+                paint_check_bounding_boxes_scalar(rotation, initialBBox, view, begin, end, expected.data());
+                for (auto fn : GetAvailableFunctions())
+                {
+                    std::vector<uint8_t> actual(end - begin, 0xFF);
+                    fn(rotation, initialBBox, view, begin, end, actual.data());
+                    ASSERT_EQ(expected, actual);
+                }
+            }
+        }
+    }
+}
+
+// Returns the indices of the paint structs in the order they will be drawn.
+static std::vector<size_t> ArrangeRandomSession(uint32_t seed, uint8_t rotation, PaintSortMethod method)
+{
+    std::mt19937 rng(seed);
+    auto session = std::make_unique<paint_session>();
+    session->CurrentRotation = rotation;
+    session->QuadrantBackIndex = UINT32_MAX;
+    session->QuadrantFrontIndex = 0;
+    std::fill(std::begin(session->Quadrants), std::end(session->Quadrants), nullptr);
+
+    std::vector<paint_struct> paintStructs(rng() % 300);
+    uint32_t firstQuadrant = rng() % 100;
+    for (auto& ps : paintStructs)
+    {
+        ps = {};
+        ps.bounds = GenerateBounds(rng, 0);
+        ps.quadrant_flags = rng() & 0xFF;
+        uint32_t quadrantIndex = firstQuadrant + rng() % 6;
+        ps.quadrant_index = quadrantIndex;
+        ps.next_quadrant_ps = session->Quadrants[quadrantIndex];
+        session->Quadrants[quadrantIndex] = &ps;
+        session->QuadrantBackIndex = std::min(session->QuadrantBackIndex, quadrantIndex);
+        session->QuadrantFrontIndex = std::max(session->QuadrantFrontIndex, quadrantIndex);
+    }
+
+    paint_session_arrange(session.get(), method);
+
+    std::vector<size_t> order;
+    for (auto ps = session->PaintHead.next_quadrant_ps; ps != nullptr; ps = ps->next_quadrant_ps)
+    {
+        order.push_back(ps - paintStructs.data());
+    }
+    return order;
+}
+
+TEST(PaintSortTest, QuadrantSoAMatchesQuadrantOrdering)
+{
+    auto previousFunction = paint_check_bounding_boxes_fn;
+    for (auto fn : GetAvailableFunctions())
+    {
+        paint_check_bounding_boxes_fn = fn;
+        for (uint32_t seed = 0; seed < 200; seed++)
+        {
+            uint8_t rotation = seed % 4;
+            auto expected = ArrangeRandomSession(seed, rotation, PaintSortMethod::Quadrant);
+            auto actual = ArrangeRandomSession(seed, rotation, PaintSortMethod::QuadrantSoA);
+            ASSERT_EQ(expected, actual);
+        }
+    }
+    paint_check_bounding_boxes_fn = previousFunction;
+}
@@ -0,0 +1,240 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <limits>
+#include <memory>
+#include <openrct2/drawing/Drawing.h>
+#include <openrct2/paint/Paint.h>
+#include <openrct2/paint/PaintTileCache.h>
+#include <openrct2/sprites.h>
+#include <openrct2/world/Map.h>
+#include <random>
+#include <vector>
+
+static constexpr int32_t NumTestImages = 8;
+
+enum class PaintCall
+{
+    Sub98196C,
+    Sub98197C,
+    Sub98198C,
+    Sub98199C,
+    AttachToPS,
+    AttachToAttach,
+};
+
+struct PaintCallArgs
+{
+    PaintCall Call;
+    uint32_t ImageId;
+    int8_t XOffset;
+    int8_t YOffset;
+    int16_t ZOffset;
+    int16_t BoundBoxLengthX;
+    int16_t BoundBoxLengthY;
+    int8_t BoundBoxLengthZ;
+};
+
+class PaintTileCacheTest : public testing::Test
+{
+protected:
+    static void SetUpTestCase()
+    {
+        // Images of different sizes and offsets, so that calls are culled independently of each other.
+        for (int32_t i = 0; i < NumTestImages; i++)
+        {
+            rct_g1_element g1 = {};
+            g1.width = 8 + i * 12;
+            g1.height = 4 + i * 9;
+            g1.x_offset = -g1.width / 2;
+            g1.y_offset = -g1.height;
+            gfx_set_g1_element(SPR_IMAGE_LIST_BEGIN + i, &g1);
+        }
+    }
+
+    static std::unique_ptr<paint_session> CreateSession(const rct_drawpixelinfo& dpi, uint8_t rotation)
+    {
+        auto session = std::make_unique<paint_session>();
+        session->DPI = dpi;
+        session->PaintEntries.Reset();
+        session->EndOfPaintStructArray = nullptr;
+        session->NextFreePaintStruct = nullptr;
+        session->LastRootPS = nullptr;
+        session->UnkF1AD2C = nullptr;
+        session->ViewFlags = 0;
+        std::fill(std::begin(session->Quadrants), std::end(session->Quadrants), nullptr);
+        session->QuadrantBackIndex = std::numeric_limits<uint32_t>::max();
+        session->QuadrantFrontIndex = 0;
+        session->CurrentRotation = rotation;
+        session->SpritePosition = { 64 * 32, 64 * 32 };
+        session->MapPosition = session->SpritePosition;
+        session->CurrentlyDrawnItem = nullptr;
+        session->InteractionType = 0;
+        session->SurfaceElement = nullptr;
+        session->TileCache = nullptr;
+        session->TileRecorder = nullptr;
+        return session;
+    }
+
+    static std::vector<PaintCallArgs> GenerateCalls(std::mt19937& rng)
+    {
+        std::vector<PaintCallArgs> calls;
+        size_t numCalls = 1 + rng() % 40;
+        for (size_t i = 0; i < numCalls; i++)
+        {
+            PaintCallArgs args;
+            // Start with a root struct, anything else would attach to state left behind by an earlier tile.
+            args.Call = i == 0 ? PaintCall::Sub98197C : (PaintCall)(rng() % 6);
+            args.ImageId = SPR_IMAGE_LIST_BEGIN + rng() % NumTestImages;
+            args.XOffset = rng() % 32;
+            args.YOffset = rng() % 32;
+            args.ZOffset = rng() % 256;
+            args.BoundBoxLengthX = 1 + rng() % 32;
+            args.BoundBoxLengthY = 1 + rng() % 32;
+            args.BoundBoxLengthZ = rng() % 64;
+            calls.push_back(args);
+        }
+        return calls;
+    }
+
+    static void PaintCalls(paint_session* session, const std::vector<PaintCallArgs>& calls)
+    {
+        for (const auto& args : calls)
+        {
+            switch (args.Call)
+            {
+                case PaintCall::Sub98196C:
+                    sub_98196C(
+                        session, args.ImageId, args.XOffset, args.YOffset, args.BoundBoxLengthX, args.BoundBoxLengthY,
+                        args.BoundBoxLengthZ, args.ZOffset);
+                    break;
+                case PaintCall::Sub98197C:
+                    sub_98197C(
+                        session, args.ImageId, args.XOffset, args.YOffset, args.BoundBoxLengthX, args.BoundBoxLengthY,
+                        args.BoundBoxLengthZ, args.ZOffset, args.XOffset, args.YOffset, args.ZOffset);
+                    break;
+                case PaintCall::Sub98198C:
+                    sub_98198C(
+                        session, args.ImageId, args.XOffset, args.YOffset, args.BoundBoxLengthX, args.BoundBoxLengthY,
+                        args.BoundBoxLengthZ, args.ZOffset, args.XOffset, args.YOffset, args.ZOffset);
+                    break;
+                case PaintCall::Sub98199C:
+                    sub_98199C(
+                        session, args.ImageId, args.XOffset, args.YOffset, args.BoundBoxLengthX, args.BoundBoxLengthY,
+                        args.BoundBoxLengthZ, args.ZOffset, args.XOffset, args.YOffset, args.ZOffset);
+                    break;
+                case PaintCall::AttachToPS:
+                    paint_attach_to_previous_ps(session, args.ImageId, args.XOffset, args.YOffset);
+                    break;
+                case PaintCall::AttachToAttach:
+                    paint_attach_to_previous_attach(session, args.ImageId, args.XOffset, args.YOffset);
+                    break;
+            }
+        }
+    }
+
+    // Flattens everything reachable from the quadrants, plus the state the next paint call would see.
+    static std::vector<uint32_t> DescribeSession(const paint_session* session)
+    {
+        std::vector<uint32_t> result;
+        auto describeStruct = [&result](const paint_struct* ps) {
+            result.insert(
+                result.end(),
+                { ps->image_id, ps->x, ps->y, ps->bounds.x, ps->bounds.y, ps->bounds.z, ps->bounds.x_end, ps->bounds.y_end,
+                  ps->bounds.z_end });
+            for (auto attached = ps->attached_ps; attached != nullptr; attached = attached->next)
+            {
+                result.insert(result.end(), { 1, attached->image_id, attached->x, attached->y });
+            }
+        };
+        for (const auto* quadrant : session->Quadrants)
+        {
+            for (auto ps = quadrant; ps != nullptr; ps = ps->next_quadrant_ps)
+            {
+                describeStruct(ps);
+                for (auto child = ps->children; child != nullptr; child = child->children)
+                {
+                    result.push_back(2);
+                    describeStruct(child);
+                }
+            }
+            result.push_back(3);
+        }
+        if (session->LastRootPS != nullptr)
+        {
+            describeStruct(session->LastRootPS);
+        }
+        result.push_back(4);
+        if (session->UnkF1AD2C != nullptr)
+        {
+            result.insert(result.end(), { session->UnkF1AD2C->image_id, session->UnkF1AD2C->x, session->UnkF1AD2C->y });
+        }
+        return result;
+    }
+};
+
+TEST_F(PaintTileCacheTest, ReplayMatchesLivePaint)
+{
+    std::mt19937 rng(7);
+    for (int32_t n = 0; n < 500; n++)
+    {
+        uint8_t rotation = n % 4;
+        auto calls = GenerateCalls(rng);
+
+        rct_drawpixelinfo unclipped = {};
+        unclipped.x = std::numeric_limits<int16_t>::min() / 2;
+        unclipped.y = std::numeric_limits<int16_t>::min() / 2;
+        unclipped.width = std::numeric_limits<int16_t>::max();
+        unclipped.height = std::numeric_limits<int16_t>::max();
+        PaintTileRecorder recorder;
+        auto recordSession = CreateSession(unclipped, rotation);
+        recordSession->TileRecorder = &recorder;
+        recorder.Begin();
+        recorder.SetScreenExtent(std::numeric_limits<int16_t>::max(), std::numeric_limits<int16_t>::min());
+        PaintCalls(recordSession.get(), calls);
+        auto recording = recorder.Finish(recordSession.get());
+        ASSERT_NE(recording, nullptr);
+
+        // Views around the painted structs, small enough to cull some of them.
+        auto centre = translate_3d_to_2d_with_z(rotation, { recordSession->SpritePosition, 128 });
+        for (int32_t v = 0; v < 8; v++)
+        {
+            rct_drawpixelinfo dpi = {};
+            dpi.x = centre.x - 64 + (int16_t)(rng() % 128);
+            dpi.y = centre.y - 128 + (int16_t)(rng() % 256);
+            dpi.width = 1 + rng() % 64;
+            dpi.height = 1 + rng() % 64;
+
+            auto liveSession = CreateSession(dpi, rotation);
+            PaintCalls(liveSession.get(), calls);
+
+            auto replaySession = CreateSession(dpi, rotation);
+            paint_session_replay_tile(replaySession.get(), *recording);
+
+            ASSERT_EQ(DescribeSession(liveSession.get()), DescribeSession(replaySession.get()));
+            ASSERT_EQ(liveSession->QuadrantBackIndex, replaySession->QuadrantBackIndex);
+            ASSERT_EQ(liveSession->QuadrantFrontIndex, replaySession->QuadrantFrontIndex);
+        }
+    }
+}
+
+TEST_F(PaintTileCacheTest, AttachingToEarlierTileIsNotRecorded)
+{
+    rct_drawpixelinfo dpi = {};
+    dpi.width = std::numeric_limits<int16_t>::max();
+    dpi.height = std::numeric_limits<int16_t>::max();
+    PaintTileRecorder recorder;
+    auto session = CreateSession(dpi, 0);
+    session->TileRecorder = &recorder;
+    recorder.Begin();
+    paint_attach_to_previous_ps(session.get(), SPR_IMAGE_LIST_BEGIN, 0, 0);
+    sub_98197C(session.get(), SPR_IMAGE_LIST_BEGIN, 0, 0, 32, 32, 1, 0, 0, 0, 0);
+    ASSERT_EQ(recorder.Finish(session.get()), nullptr);
+}
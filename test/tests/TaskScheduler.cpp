@@ -0,0 +1,99 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+#include <atomic>
+#include <gtest/gtest.h>
+#include <openrct2/core/TaskScheduler.h>
+#include <stdint.h>
+#include <thread>
+#include <vector>
+
+TEST(TaskSchedulerTest, ParallelForVisitsEveryIndexOnce)
+{
+    TaskScheduler scheduler;
+    for (size_t count : { 0, 1, 7, 64, 1000, 12345 })
+    {
+        std::vector<std::atomic<uint32_t>> visits(count);
+        scheduler.ParallelFor(count, [&visits](size_t i) { visits[i]++; });
+        for (size_t i = 0; i < count; i++)
+        {
+            ASSERT_EQ(visits[i].load(), 1U);
+        }
+    }
+}
+
+TEST(TaskSchedulerTest, ParallelForRangeRespectsGrainSize)
+{
+    TaskScheduler scheduler;
+    constexpr size_t count = 1000;
+    constexpr size_t grainSize = 33;
+    std::atomic<size_t> total = { 0 };
+    std::atomic<bool> validRanges = { true };
+    scheduler.ParallelForRange(count, grainSize, [&](size_t begin, size_t end) {
+        if (begin % grainSize != 0 || end <= begin || end - begin > grainSize || end > count)
+        {
+            validRanges = false;
+        }
+        total += end - begin;
+    });
+    ASSERT_TRUE(validRanges);
+    ASSERT_EQ(total.load(), count);
+}
+
+TEST(TaskSchedulerTest, NestedParallelFor)
+{
+    TaskScheduler scheduler;
+    constexpr size_t outerCount = 32;
+    constexpr size_t innerCount = 100;
+    std::vector<std::atomic<uint32_t>> visits(outerCount * innerCount);
+    scheduler.ParallelFor(outerCount, [&](size_t i) {
+        scheduler.ParallelFor(innerCount, [&](size_t j) { visits[i * innerCount + j]++; });
+    });
+    for (auto& v : visits)
+    {
+        ASSERT_EQ(v.load(), 1U);
+    }
+}
+
+TEST(TaskSchedulerTest, SingleThread)
+{
+    TaskScheduler scheduler(1);
+    ASSERT_EQ(scheduler.GetConcurrency(), 1U);
+    std::thread::id callerId = std::this_thread::get_id();
+    bool sameThread = true;
+    size_t sum = 0;
+    scheduler.ParallelFor(100, [&](size_t i) {
+        sameThread &= std::this_thread::get_id() == callerId;
+        sum += i;
+    });
+    ASSERT_TRUE(sameThread);
+    ASSERT_EQ(sum, 4950U);
+}
+
+TEST(TaskSchedulerTest, MultipleSubmitters)
+{
+    TaskScheduler scheduler;
+    constexpr size_t numSubmitters = 4;
+    constexpr size_t count = 500;
+    std::atomic<size_t> total = { 0 };
+    std::vector<std::thread> submitters;
+    for (size_t n = 0; n < numSubmitters; n++)
+    {
+        submitters.emplace_back([&]() {
+            for (int32_t repeat = 0; repeat < 20; repeat++)
+            {
+                scheduler.ParallelFor(count, [&](size_t) { total++; });
+            }
+        });
+    }
+    for (auto& th : submitters)
+    {
+        th.join();
+    }
+    ASSERT_EQ(total.load(), numSubmitters * count * 20);
+}
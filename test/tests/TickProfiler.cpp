@@ -0,0 +1,82 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+#include <array>
+#include <gtest/gtest.h>
+#include <openrct2/TickProfiler.h>
+
+static std::array<uint64_t, TickProfiler::NumStages> MakeStages(uint64_t peeps)
+{
+    std::array<uint64_t, TickProfiler::NumStages> stages{};
+    stages[(size_t)TickStage::Peeps] = peeps;
+    return stages;
+}
+
+TEST(TickProfilerTest, Percentiles)
+{
+    TickProfiler profiler;
+    for (uint64_t i = 1; i <= 100; i++)
+    {
+        profiler.AddTick(MakeStages(i), i * 2);
+    }
+
+    auto stats = profiler.GetStageStatistics(TickStage::Peeps);
+    ASSERT_EQ(stats.Mean, 50U);
+    ASSERT_EQ(stats.Median, 50U);
+    ASSERT_EQ(stats.P95, 95U);
+    ASSERT_EQ(stats.P99, 99U);
+    ASSERT_EQ(stats.Max, 100U);
+
+    auto total = profiler.GetTotalStatistics();
+    ASSERT_EQ(total.Median, 100U);
+    ASSERT_EQ(total.Max, 200U);
+
+    auto empty = profiler.GetStageStatistics(TickStage::Vehicles);
+    ASSERT_EQ(empty.Max, 0U);
+}
+
+TEST(TickProfilerTest, HistoryKeepsMostRecentTicks)
+{
+    TickProfiler profiler;
+    size_t numTicks = TickProfiler::HistorySize + 10;
+    for (size_t i = 0; i < numTicks; i++)
+    {
+        profiler.AddTick(MakeStages(i), i);
+    }
+    ASSERT_EQ(profiler.GetNumTicks(), TickProfiler::HistorySize);
+    ASSERT_EQ(profiler.GetTotalTicks(), numTicks);
+
+    auto stats = profiler.GetStageStatistics(TickStage::Peeps);
+    ASSERT_EQ(stats.Max, numTicks - 1);
+    ASSERT_EQ(stats.Median, 10U + TickProfiler::HistorySize / 2 - 1);
+
+    profiler.Reset();
+    ASSERT_EQ(profiler.GetNumTicks(), 0U);
+    ASSERT_EQ(profiler.GetTotalTicks(), 0U);
+}
+
+TEST(TickProfilerTest, ScopesOnlyRecordWhileEnabled)
+{
+    TickProfiler profiler;
+    {
+        TickProfiler::TickScope tickScope(profiler);
+        TickProfiler::StageScope stageScope(profiler, TickStage::Rides);
+    }
+    ASSERT_EQ(profiler.GetNumTicks(), 0U);
+
+    profiler.SetEnabled(true);
+    {
+        TickProfiler::TickScope tickScope(profiler);
+        TickProfiler::StageScope stageScope(profiler, TickStage::Rides);
+    }
+    {
+        TickProfiler::TickScope tickScope(profiler);
+        tickScope.Discard();
+    }
+    ASSERT_EQ(profiler.GetNumTicks(), 1U);
+}